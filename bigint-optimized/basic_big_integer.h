@@ -0,0 +1,297 @@
+#ifndef BIGINT__BASIC_BIG_INTEGER_H_
+#define BIGINT__BASIC_BIG_INTEGER_H_
+
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <functional>
+#include "buffer.h"
+#include "vector_storage.h"
+
+struct expr_ops;
+struct compact_big_integer;
+struct literal_ops;
+struct big_decimal_integer;
+struct big_rational;
+struct big_float;
+template<size_t Bits, bool Signed>
+struct fixed_int;
+
+// Sign and magnitude arithmetic over limbs kept in Storage, least significant first. A Storage provides
+//   explicit Storage(uint32_t limb)             a single limb, the storage is never empty after that
+//   copy and move construction and assignment   moved-from storages only have to be assignable and destructible
+//   get_size(), capacity()                      in limbs
+//   operator[], back()                          the mutable operator[] may copy shared limbs
+//   span(), span() const, cspan() const         limb_span and const_limb_span over all limbs; only the mutable
+//                                               span may copy shared limbs, and it stays valid until the size
+//                                               or the capacity changes
+//   push_back(limb), pop_back()
+//   resize(n), resize(n, fill), reserve(n)      resize(n) leaves new limbs unspecified
+//   drop_front(k), insert_front(k)              remove the k lowest limbs or add k zero limbs below them
+//   decimal(render)                             the digits of the magnitude from render(), or a copy of them kept
+//                                               from an earlier call while the limbs haven't changed; the kept
+//                                               copy is dropped when a mutable span or limb is handed out, so
+//                                               one must not be held across a call
+// The arithmetic is compiled once per storage in big_integer.cpp and big_integer_math.cpp.
+template<typename Storage>
+struct basic_big_integer {
+  basic_big_integer();
+  basic_big_integer(basic_big_integer const& value);
+  basic_big_integer(basic_big_integer&& value) noexcept;
+  basic_big_integer(int value);
+  explicit basic_big_integer(std::string const& str);
+  ~basic_big_integer();
+
+  basic_big_integer& operator=(basic_big_integer const& a);
+  basic_big_integer& operator=(basic_big_integer&& a) noexcept;
+
+  // evaluates a lazy expression from big_integer_expr.h into this number's storage
+  template<typename E, typename = typename E::expression_tag>
+  basic_big_integer& operator=(E const& e);
+
+  basic_big_integer& operator+=(basic_big_integer const& a);
+  basic_big_integer& operator-=(basic_big_integer const& a);
+  basic_big_integer& operator*=(basic_big_integer const& a);
+  basic_big_integer& operator/=(basic_big_integer const& a);
+  basic_big_integer& operator%=(basic_big_integer const& a);
+  basic_big_integer& operator&=(basic_big_integer const& a);
+  basic_big_integer& operator|=(basic_big_integer const& a);
+  basic_big_integer& operator^=(basic_big_integer const& a);
+
+  basic_big_integer& operator<<=(int value);
+  basic_big_integer& operator>>=(int value);
+
+  basic_big_integer operator+() const;
+  basic_big_integer operator-() const;
+  basic_big_integer operator~() const;
+
+  basic_big_integer& operator++();
+  basic_big_integer operator++(int);
+
+  basic_big_integer& operator--();
+  basic_big_integer operator--(int);
+
+  // room for at least n limbs, so an accumulator can grow without reallocating
+  void reserve(size_t n);
+  size_t capacity() const;
+
+  // number theory for every storage, big_integer.h has free functions for the default one
+  static basic_big_integer isqrt(basic_big_integer const& a) {
+    return iroot(a, 2);
+  }
+  static basic_big_integer iroot(basic_big_integer const& a, uint32_t k);
+  static bool is_square(basic_big_integer const& a);
+  // non-negative, gcd(0, 0) = 0
+  static basic_big_integer gcd(basic_big_integer const& a, basic_big_integer const& b);
+  static basic_big_integer pow(basic_big_integer const& base, uint64_t exp);
+  static basic_big_integer factorial(uint32_t n);
+  static basic_big_integer binomial(uint32_t n, uint32_t k);
+  // trial division, then Baillie-PSW plus rounds extra Miller-Rabin bases
+  static bool is_probable_prime(basic_big_integer const& n, size_t rounds = 0);
+
+  // the friends are found by argument-dependent lookup and forward to the members compiled per storage
+
+  friend basic_big_integer operator+(basic_big_integer a, basic_big_integer const& b) {
+    a += b;
+    return a;
+  }
+
+  friend basic_big_integer operator-(basic_big_integer a, basic_big_integer const& b) {
+    a -= b;
+    return a;
+  }
+
+  friend basic_big_integer operator*(basic_big_integer const& a, basic_big_integer const& b) {
+    basic_big_integer res;
+    mul_to(res, a, b);
+    return res;
+  }
+
+  friend basic_big_integer operator/(basic_big_integer a, basic_big_integer const& b) {
+    basic_big_integer q;
+    a.div_mod(b, q);
+    return q;
+  }
+
+  friend basic_big_integer operator%(basic_big_integer a, basic_big_integer const& b) {
+    basic_big_integer q;
+    a.div_mod(b, q);
+    return a;
+  }
+
+  friend basic_big_integer operator&(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.binary_operation(b, [] (uint32_t a, uint32_t b) { return a & b; });
+  }
+
+  friend basic_big_integer operator|(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.binary_operation(b, [] (uint32_t a, uint32_t b) { return a | b; });
+  }
+
+  friend basic_big_integer operator^(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.binary_operation(b, [] (uint32_t a, uint32_t b) { return a ^ b; });
+  }
+
+  friend basic_big_integer operator<<(basic_big_integer const& a, int b) {
+    return shift_left(a, b);
+  }
+
+  // rounds towards minus infinity
+  friend basic_big_integer operator>>(basic_big_integer const& a, int b) {
+    return shift_right(a, b);
+  }
+
+  friend bool operator==(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) == 0;
+  }
+
+  friend bool operator!=(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) != 0;
+  }
+
+  friend bool operator<(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) < 0;
+  }
+
+  friend bool operator>(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) > 0;
+  }
+
+  friend bool operator<=(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) <= 0;
+  }
+
+  friend bool operator>=(basic_big_integer const& a, basic_big_integer const& b) {
+    return a.compare(b) >= 0;
+  }
+
+  friend std::string to_string(basic_big_integer const& a) {
+    return to_decimal(a);
+  }
+
+  friend std::ostream& operator<<(std::ostream& s, basic_big_integer const& a) {
+    return s << to_decimal(a);
+  }
+
+  // results go to storage owned by the caller, its capacity is reused between calls
+
+  friend void add(basic_big_integer& res, basic_big_integer const& a, basic_big_integer const& b) {
+    if (&res == &b) {
+      res += a;
+    } else {
+      res.copy_from(a);
+      res += b;
+    }
+  }
+
+  friend void sub(basic_big_integer& res, basic_big_integer const& a, basic_big_integer const& b) {
+    if (&res == &b && &res != &a) {
+      res -= a;
+      res.sign = !res.sign;
+      res.normalize();
+    } else {
+      res.copy_from(a);
+      res -= b;
+    }
+  }
+
+  friend void mul(basic_big_integer& res, basic_big_integer const& a, basic_big_integer const& b) {
+    mul_to(res, a, b);
+  }
+
+  friend void addmul(basic_big_integer& acc, basic_big_integer const& a, basic_big_integer const& b) {
+    acc.add_mul(a, b, false);
+  }
+
+  friend void submul(basic_big_integer& acc, basic_big_integer const& a, basic_big_integer const& b) {
+    acc.add_mul(a, b, true);
+  }
+
+  // q and r must be different numbers
+  friend void divmod(basic_big_integer& q, basic_big_integer& r, basic_big_integer const& a,
+                     basic_big_integer const& b) {
+    if (&q == &b || &r == &b) {
+      basic_big_integer divisor(b);
+      divmod(q, r, a, divisor);
+      return;
+    }
+    r.copy_from(a);
+    r.div_mod(b, q);
+  }
+
+  bool sign;
+ private:
+  friend struct expr_ops;
+  friend struct compact_big_integer;
+  friend struct literal_ops;
+  friend struct big_decimal_integer;
+  friend struct big_rational;
+  friend struct big_float;
+  template<size_t Bits, bool Signed>
+  friend struct fixed_int;
+
+  Storage value;
+
+  basic_big_integer(uint32_t value);
+  explicit basic_big_integer(size_t n);
+
+  uint32_t& operator[](size_t i);
+  void push_back(uint32_t x);
+  void pop_back();
+  void normalize();
+
+  int32_t compare(basic_big_integer const& b) const;
+  int32_t compare_abs(basic_big_integer const& b) const;
+  uint32_t const& operator[](size_t i) const;
+  size_t size() const;
+  uint32_t const& back() const;
+
+  static basic_big_integer from_uint64(uint64_t x);
+  bool is_zero() const;
+  size_t bit_length() const;
+  uint64_t top_bits(size_t& shift) const;
+  uint32_t short_mod(uint32_t b) const;
+  basic_big_integer square() const;
+  static void square_to(basic_big_integer& res, basic_big_integer const& a);
+
+  void copy_from(basic_big_integer const& a);
+  void div_mod(basic_big_integer const& b, basic_big_integer& q);
+  void mul_short(uint32_t b);
+  void add_mul(basic_big_integer const& a, basic_big_integer const& b, bool negate);
+  uint32_t short_div(uint32_t b);
+  void add_abs(basic_big_integer const& b);
+  bool sub_abs(basic_big_integer const& b);
+  static void mul_to(basic_big_integer& res, basic_big_integer const& a, basic_big_integer const& b);
+
+  void additional_code();
+  basic_big_integer binary_operation(basic_big_integer const& b,
+                                     const std::function<uint32_t(uint32_t, uint32_t)>& func) const;
+  static basic_big_integer shift_left(basic_big_integer const& a, int b);
+  static basic_big_integer shift_right(basic_big_integer const& a, int b);
+  static std::string to_decimal(basic_big_integer const& a);
+  static std::string magnitude_digits(basic_big_integer const& a);
+  static void write_digits(basic_big_integer const& a, size_t width, std::string& out);
+  static basic_big_integer parse_digits(char const* first, char const* last);
+};
+
+extern template struct basic_big_integer<buffer>;
+extern template struct basic_big_integer<vector_storage>;
+extern template struct basic_big_integer<pooled_storage>;
+
+// balanced product tree, keeps the operands of every multiplication of similar size
+template<typename It>
+typename std::iterator_traits<It>::value_type product(It first, It last) {
+  typedef typename std::iterator_traits<It>::value_type number;
+  auto n = std::distance(first, last);
+  if (n == 0) {
+    return number(1);
+  }
+  if (n == 1) {
+    return *first;
+  }
+
+  It mid = std::next(first, n / 2);
+  return product(first, mid) * product(mid, last);
+}
+
+#endif //BIGINT__BASIC_BIG_INTEGER_H_
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include "big_decimal_integer.h"
+#include "scratch_arena.h"
+
+namespace {
+uint32_t const BASE = big_decimal_integer::BASE;
+
+// a[0, n) -= b[0, bn), a is not smaller
+void sub_from(uint32_t* a, size_t n, uint32_t const* b, size_t bn) {
+  uint32_t borrow = 0;
+  for (size_t i = 0; i < n && (i < bn || borrow != 0); i++) {
+    int64_t tmp = static_cast<int64_t>(a[i]) - (i < bn ? b[i] : 0) - borrow;
+    borrow = tmp < 0;
+    a[i] = static_cast<uint32_t>(tmp + borrow * static_cast<int64_t>(BASE));
+  }
+}
+
+// a[0, m) < b[0, m)
+bool smaller(uint32_t const* a, uint32_t const* b, size_t m) {
+  for (size_t i = m; i != 0; i--) {
+    if (a[i - 1] != b[i - 1]) {
+      return a[i - 1] < b[i - 1];
+    }
+  }
+  return false;
+}
+
+// the quotient limb estimated from the two top limbs of the window, at most 2 too large
+uint32_t trial(uint32_t const* a, size_t m, uint32_t divider) {
+  uint64_t dividend = static_cast<uint64_t>(a[m - 1]) * BASE + a[m - 2];
+  return static_cast<uint32_t>(std::min<uint64_t>(dividend / divider, BASE - 1));
+}
+
+// digits of x, exactly width of them when width is not 0
+char* write_limb(char* out, uint32_t x, size_t width) {
+  char digits[big_decimal_integer::BASE_DIGITS];
+  size_t n = 0;
+  do {
+    digits[n++] = static_cast<char>('0' + x % 10);
+    x /= 10;
+  } while (x != 0);
+  while (n < width) {
+    digits[n++] = '0';
+  }
+  return std::reverse_copy(digits, digits + n, out);
+}
+}
+
+constexpr uint32_t big_decimal_integer::BASE;
+constexpr size_t big_decimal_integer::BASE_DIGITS;
+
+big_decimal_integer::big_decimal_integer() : sign(false), value(0) {}
+
+big_decimal_integer::big_decimal_integer(int a) : sign(a < 0), value(0) {
+  uint64_t x = a < 0 ? -static_cast<uint64_t>(a) : a;
+  value[0] = static_cast<uint32_t>(x % BASE);
+  if (x >= BASE) {
+    value.push_back(static_cast<uint32_t>(x / BASE));
+  }
+}
+
+// every limb is read from its 9 digits, counted from the end
+big_decimal_integer::big_decimal_integer(std::string const& str) : big_decimal_integer() {
+  size_t first = !str.empty() && (str[0] == '-' || str[0] == '+');
+  if (first == str.size()) {
+    return;
+  }
+
+  size_t digits = str.size() - first;
+  value.resize((digits + BASE_DIGITS - 1) / BASE_DIGITS);
+  limb_span x = value.span();
+  for (size_t i = 0; i != x.size; ++i) {
+    size_t end = str.size() - i * BASE_DIGITS;
+    size_t begin = end - std::min(BASE_DIGITS, end - first);
+    uint32_t limb = 0;
+    for (size_t j = begin; j != end; ++j) {
+      limb = limb * 10 + static_cast<uint32_t>(str[j] - '0');
+    }
+    x.data[i] = limb;
+  }
+  sign = str[0] == '-';
+  normalize();
+}
+
+// Horner's scheme over the binary limbs, from the top
+big_decimal_integer::big_decimal_integer(big_integer const& a) : big_decimal_integer() {
+  const_limb_span x = a.value.cspan();
+  for (size_t i = x.size; i != 0; i--) {
+    mul_add_short(static_cast<uint64_t>(1) << 32, x.data[i - 1]);
+  }
+  sign = a.sign;
+  normalize();
+}
+
+big_integer big_decimal_integer::to_big_integer() const {
+  const_limb_span x = value.cspan();
+  big_integer res;
+  // a limb of 10^9 takes less than 30 bits
+  res.reserve(x.size * 30 / 32 + 1);
+  for (size_t i = x.size; i != 0; i--) {
+    res.mul_short(BASE);
+    res.add_abs(big_integer(x.data[i - 1]));
+  }
+  res.sign = sign && !res.is_zero();
+  return res;
+}
+
+big_decimal_integer& big_decimal_integer::operator+=(big_decimal_integer const& a) {
+  add_signed(a, a.sign);
+  return *this;
+}
+
+big_decimal_integer& big_decimal_integer::operator-=(big_decimal_integer const& a) {
+  add_signed(a, !a.sign);
+  return *this;
+}
+
+big_decimal_integer& big_decimal_integer::operator*=(big_decimal_integer const& a) {
+  size_t n = size(), m = a.size();
+  big_decimal_integer res;
+  res.value.resize(n + m, 0);
+  limb_span r = res.value.span();
+  const_limb_span x = value.cspan(), y = a.value.cspan();
+  for (size_t i = 0; i != n; ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j != m; ++j) {
+      uint64_t cur = r.data[i + j] + static_cast<uint64_t>(x.data[i]) * y.data[j] + carry;
+      r.data[i + j] = static_cast<uint32_t>(cur % BASE);
+      carry = cur / BASE;
+    }
+    r.data[i + m] = static_cast<uint32_t>(carry);
+  }
+  res.sign = sign != a.sign;
+  res.normalize();
+  return *this = res;
+}
+
+big_decimal_integer& big_decimal_integer::operator/=(big_decimal_integer const& a) {
+  big_decimal_integer q;
+  div_mod(a, q);
+  return *this = q;
+}
+
+big_decimal_integer& big_decimal_integer::operator%=(big_decimal_integer const& a) {
+  big_decimal_integer q;
+  div_mod(a, q);
+  return *this;
+}
+
+big_decimal_integer big_decimal_integer::operator+() const {
+  return *this;
+}
+
+big_decimal_integer big_decimal_integer::operator-() const {
+  big_decimal_integer res(*this);
+  res.sign = !res.sign;
+  res.normalize();
+  return res;
+}
+
+big_decimal_integer& big_decimal_integer::operator++() {
+  return *this += 1;
+}
+
+big_decimal_integer big_decimal_integer::operator++(int) {
+  big_decimal_integer res = *this;
+  ++*this;
+  return res;
+}
+
+big_decimal_integer& big_decimal_integer::operator--() {
+  return *this -= 1;
+}
+
+big_decimal_integer big_decimal_integer::operator--(int) {
+  big_decimal_integer res = *this;
+  --*this;
+  return res;
+}
+
+// the top limb without padding, every other one as exactly 9 digits
+std::string to_string(big_decimal_integer const& a) {
+  const_limb_span x = a.value.cspan();
+  std::string res(a.sign + x.size * big_decimal_integer::BASE_DIGITS, '-');
+  char* out = &res[a.sign];
+  out = write_limb(out, x.data[x.size - 1], 0);
+  for (size_t i = x.size - 1; i != 0; i--) {
+    out = write_limb(out, x.data[i - 1], big_decimal_integer::BASE_DIGITS);
+  }
+  res.resize(static_cast<size_t>(out - res.data()));
+  return res;
+}
+
+size_t big_decimal_integer::size() const {
+  return value.get_size();
+}
+
+void big_decimal_integer::normalize() {
+  while (size() > 1 && value.back() == 0) {
+    value.pop_back();
+  }
+  if (is_zero()) {
+    sign = false;
+  }
+}
+
+bool big_decimal_integer::is_zero() const {
+  return size() == 1 && value[0] == 0;
+}
+
+int32_t big_decimal_integer::compare(big_decimal_integer const& b) const {
+  if (sign != b.sign) {
+    return sign ? -1 : 1;
+  }
+  int32_t res = compare_abs(b);
+  return sign ? -res : res;
+}
+
+int32_t big_decimal_integer::compare_abs(big_decimal_integer const& b) const {
+  if (size() != b.size()) {
+    return size() < b.size() ? -1 : 1;
+  }
+  const_limb_span x = value.cspan(), y = b.value.cspan();
+  for (size_t i = x.size; i != 0; i--) {
+    if (x.data[i - 1] != y.data[i - 1]) {
+      return x.data[i - 1] < y.data[i - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+void big_decimal_integer::add_signed(big_decimal_integer const& b, bool b_sign) {
+  if (sign == b_sign) {
+    add_abs(b);
+  } else if (sub_abs(b)) {
+    sign = b_sign;
+  }
+  normalize();
+}
+
+// the carry is computed without branches, so the loop stays vectorizable
+void big_decimal_integer::add_abs(big_decimal_integer const& b) {
+  size_t m = b.size();
+  value.resize(std::max(size(), m) + 1, 0);
+  limb_span x = value.span();
+  const_limb_span y = b.value.cspan();
+  uint32_t carry = 0;
+  for (size_t i = 0; i != m; ++i) {
+    uint32_t s = x.data[i] + y.data[i] + carry;
+    carry = s >= BASE;
+    x.data[i] = s - carry * BASE;
+  }
+  for (size_t i = m; carry != 0; ++i) {
+    uint32_t s = x.data[i] + carry;
+    carry = s >= BASE;
+    x.data[i] = s - carry * BASE;
+  }
+}
+
+bool big_decimal_integer::sub_abs(big_decimal_integer const& b) {
+  if (compare_abs(b) >= 0) {
+    limb_span x = value.span();
+    const_limb_span y = b.value.cspan();
+    sub_from(x.data, x.size, y.data, y.size);
+    return false;
+  }
+
+  // |b| - |this|, b is longer or has a larger top limb
+  size_t n = size();
+  value.resize(b.size(), 0);
+  limb_span x = value.span();
+  const_limb_span y = b.value.cspan();
+  uint32_t borrow = 0;
+  for (size_t i = 0; i != x.size; ++i) {
+    int64_t tmp = static_cast<int64_t>(y.data[i]) - (i < n ? x.data[i] : 0) - borrow;
+    borrow = tmp < 0;
+    x.data[i] = static_cast<uint32_t>(tmp + borrow * static_cast<int64_t>(BASE));
+  }
+  return true;
+}
+
+// this = this * b + add, for b up to 2^32
+void big_decimal_integer::mul_add_short(uint64_t b, uint32_t add) {
+  limb_span x = value.span();
+  uint64_t carry = add;
+  for (size_t i = 0; i != x.size; ++i) {
+    uint64_t cur = x.data[i] * b + carry;
+    x.data[i] = static_cast<uint32_t>(cur % BASE);
+    carry = cur / BASE;
+  }
+  while (carry != 0) {
+    value.push_back(static_cast<uint32_t>(carry % BASE));
+    carry /= BASE;
+  }
+}
+
+uint32_t big_decimal_integer::short_div(uint32_t b) {
+  limb_span x = value.span();
+  uint64_t rem = 0;
+  for (size_t i = x.size; i != 0; i--) {
+    uint64_t cur = rem * BASE + x.data[i - 1];
+    x.data[i - 1] = static_cast<uint32_t>(cur / b);
+    rem = cur % b;
+  }
+  return static_cast<uint32_t>(rem);
+}
+
+// truncating, the remainder stays in this; the same long division as big_integer's in base 10^9
+void big_decimal_integer::div_mod(big_decimal_integer const& b, big_decimal_integer& q) {
+  bool q_sign = sign != b.sign;
+  bool this_sign = sign;
+
+  if (compare_abs(b) < 0) {
+    q = 0;
+    return;
+  }
+
+  if (b.size() == 1) {
+    q = *this;
+    uint32_t rem = q.short_div(b.value[0]);
+    q.sign = q_sign;
+    q.normalize();
+
+    value.resize(1);
+    value[0] = rem;
+    sign = this_sign;
+    normalize();
+    return;
+  }
+
+  uint32_t normalize_factor = BASE / (b.value.back() + 1);
+  size_t n = b.size(), m = n + 1;
+  value.reserve(size() + 2);
+  mul_add_short(normalize_factor, 0);
+  value.push_back(0);
+
+  scratch_arena::frame frame;
+  uint32_t* divider = frame.allocate(n);
+  uint32_t* dq = frame.allocate(m);
+  const_limb_span d = b.value.cspan();
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t tmp = static_cast<uint64_t>(d.data[i]) * normalize_factor + carry;
+    divider[i] = static_cast<uint32_t>(tmp % BASE);
+    carry = tmp / BASE;
+  }
+
+  q.value.resize(size() - n);
+  limb_span r = value.span(), qs = q.value.span();
+  for (size_t j = qs.size; j != 0; j--) {
+    uint32_t* window = r.data + j - 1;
+    uint32_t qt = trial(window, m, divider[n - 1]);
+    carry = 0;
+    for (size_t i = 0; i < n; i++) {
+      uint64_t tmp = static_cast<uint64_t>(divider[i]) * qt + carry;
+      dq[i] = static_cast<uint32_t>(tmp % BASE);
+      carry = tmp / BASE;
+    }
+    dq[n] = static_cast<uint32_t>(carry);
+
+    while (smaller(window, dq, m)) {
+      qt--;
+      sub_from(dq, m, divider, n);
+    }
+    qs.data[j - 1] = qt;
+    sub_from(window, m, dq, m);
+  }
+  value.resize(n);
+
+  q.sign = q_sign;
+  q.normalize();
+
+  sign = this_sign;
+  short_div(normalize_factor);
+  normalize();
+}
@@ -0,0 +1,107 @@
+#ifndef BIGINT__BIG_DECIMAL_INTEGER_H_
+#define BIGINT__BIG_DECIMAL_INTEGER_H_
+
+#include <ostream>
+#include <string>
+#include "big_integer.h"
+
+// Sign and magnitude in base 10^9 limbs, least significant first, kept in the same buffer as big_integer.
+// Reading and printing decimal text is linear, addition and subtraction are as cheap as in binary, multiplication
+// and division are the schoolbook ones. No bitwise operations, they have no meaning in this base.
+struct big_decimal_integer {
+  static constexpr uint32_t BASE = 1000000000;
+  static constexpr size_t BASE_DIGITS = 9;
+
+  big_decimal_integer();
+  big_decimal_integer(int a);
+  explicit big_decimal_integer(std::string const& str);
+  explicit big_decimal_integer(big_integer const& a);
+
+  big_integer to_big_integer() const;
+
+  big_decimal_integer& operator+=(big_decimal_integer const& a);
+  big_decimal_integer& operator-=(big_decimal_integer const& a);
+  big_decimal_integer& operator*=(big_decimal_integer const& a);
+  big_decimal_integer& operator/=(big_decimal_integer const& a);
+  big_decimal_integer& operator%=(big_decimal_integer const& a);
+
+  big_decimal_integer operator+() const;
+  big_decimal_integer operator-() const;
+
+  big_decimal_integer& operator++();
+  big_decimal_integer operator++(int);
+
+  big_decimal_integer& operator--();
+  big_decimal_integer operator--(int);
+
+  friend big_decimal_integer operator+(big_decimal_integer a, big_decimal_integer const& b) {
+    return a += b;
+  }
+
+  friend big_decimal_integer operator-(big_decimal_integer a, big_decimal_integer const& b) {
+    return a -= b;
+  }
+
+  friend big_decimal_integer operator*(big_decimal_integer const& a, big_decimal_integer const& b) {
+    big_decimal_integer res(a);
+    return res *= b;
+  }
+
+  friend big_decimal_integer operator/(big_decimal_integer a, big_decimal_integer const& b) {
+    return a /= b;
+  }
+
+  friend big_decimal_integer operator%(big_decimal_integer a, big_decimal_integer const& b) {
+    return a %= b;
+  }
+
+  friend bool operator==(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) == 0;
+  }
+
+  friend bool operator!=(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) != 0;
+  }
+
+  friend bool operator<(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) < 0;
+  }
+
+  friend bool operator>(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) > 0;
+  }
+
+  friend bool operator<=(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) <= 0;
+  }
+
+  friend bool operator>=(big_decimal_integer const& a, big_decimal_integer const& b) {
+    return a.compare(b) >= 0;
+  }
+
+  friend std::string to_string(big_decimal_integer const& a);
+
+  friend std::ostream& operator<<(std::ostream& s, big_decimal_integer const& a) {
+    return s << to_string(a);
+  }
+
+  bool sign;
+ private:
+  buffer value;
+
+  size_t size() const;
+  void normalize();
+  bool is_zero() const;
+
+  int32_t compare(big_decimal_integer const& b) const;
+  int32_t compare_abs(big_decimal_integer const& b) const;
+  void add_abs(big_decimal_integer const& b);
+  // |this| - |b|, returns whether the result changed sign
+  bool sub_abs(big_decimal_integer const& b);
+  void add_signed(big_decimal_integer const& b, bool b_sign);
+  void mul_add_short(uint64_t b, uint32_t add);
+  uint32_t short_div(uint32_t b);
+  void div_mod(big_decimal_integer const& b, big_decimal_integer& q);
+};
+
+#endif //BIGINT__BIG_DECIMAL_INTEGER_H_
@@ -0,0 +1,445 @@
+#include <cmath>
+#include <stdexcept>
+#include "big_float.h"
+
+namespace {
+// below this many bits of precision reciprocals, inverse square roots and quotients come from plain division
+size_t const NEWTON_BASECASE_BITS = 2048;
+// extra bits carried by every Newton step and by the approximate quotients and roots
+size_t const GUARD_BITS = 32;
+
+size_t checked(size_t precision) {
+  if (precision == 0) {
+    throw std::invalid_argument("big_float needs at least one bit of precision");
+  }
+  return precision;
+}
+}
+
+constexpr size_t big_float::DEFAULT_PRECISION;
+
+big_float::big_float() : mant(0), exp(0), prec(DEFAULT_PRECISION) {}
+
+big_float::big_float(int a, size_t precision) : exp(0), prec(checked(precision)) {
+  big_integer m(a);
+  assign(a < 0, magnitude(m), 0, false);
+}
+
+big_float::big_float(double a, size_t precision) : exp(0), prec(checked(precision)) {
+  if (!std::isfinite(a)) {
+    throw std::domain_error("big_float of an infinity or NaN");
+  }
+  int e;
+  double f = std::frexp(std::fabs(a), &e);
+  assign(a < 0, big_integer::from_uint64(static_cast<uint64_t>(std::ldexp(f, 53))), e - 53, false);
+}
+
+big_float::big_float(big_integer const& a, size_t precision) : exp(0), prec(checked(precision)) {
+  assign(a.sign, magnitude(a), 0, false);
+}
+
+big_float::big_float(big_integer const& mantissa, int64_t exponent, size_t precision)
+    : exp(0), prec(checked(precision)) {
+  assign(mantissa.sign, magnitude(mantissa), exponent, false);
+}
+
+big_float::big_float(big_float const& a, size_t precision) : exp(0), prec(checked(precision)) {
+  assign(a.mant.sign, magnitude(a.mant), a.exp, false);
+}
+
+big_float::big_float(std::string const& str, size_t precision) : exp(0), prec(checked(precision)) {
+  size_t i = 0;
+  bool negative = false;
+  if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+    negative = str[i++] == '-';
+  }
+  std::string digits;
+  int64_t e10 = 0;
+  bool point = false;
+  for (; i < str.size(); ++i) {
+    if (str[i] >= '0' && str[i] <= '9') {
+      digits += str[i];
+      e10 -= point;
+    } else if (str[i] == '.' && !point) {
+      point = true;
+    } else {
+      break;
+    }
+  }
+  if (digits.empty()) {
+    throw std::invalid_argument("big_float needs digits");
+  }
+  if (i < str.size()) {
+    size_t used = 0;
+    if ((str[i] != 'e' && str[i] != 'E') || i + 1 == str.size()) {
+      throw std::invalid_argument("not a decimal number");
+    }
+    e10 += std::stoll(str.substr(i + 1), &used);
+    if (i + 1 + used != str.size()) {
+      throw std::invalid_argument("not a decimal number");
+    }
+  }
+
+  // one rounding of the exact value
+  big_integer m(digits);
+  if (e10 >= 0) {
+    assign(negative, m * pow(big_integer(10), e10), 0, false);
+  } else {
+    big_integer scale = pow(big_integer(10), -e10);
+    *this = div(big_float(m, 0, std::max<size_t>(bits(m), 1)), big_float(scale, 0, bits(scale)), prec);
+    if (negative) {
+      mant = -mant;
+    }
+  }
+}
+
+big_integer const& big_float::mantissa() const {
+  return mant;
+}
+
+int64_t big_float::exponent() const {
+  return exp;
+}
+
+size_t big_float::precision() const {
+  return prec;
+}
+
+big_float big_float::ulp() const {
+  return big_float(big_integer(1), exp + static_cast<int64_t>(bits(mant)) - static_cast<int64_t>(prec), prec);
+}
+
+big_integer big_float::to_big_integer() const {
+  if (exp >= 0) {
+    return mant << static_cast<int>(exp);
+  }
+  if (static_cast<uint64_t>(-exp) >= bits(mant)) {
+    return 0;
+  }
+  big_integer res = magnitude(mant) >> static_cast<int>(-exp);
+  return mant.sign ? -res : res;
+}
+
+double big_float::to_double() const {
+  big_float a(*this, 53);
+  size_t shift;
+  double res = static_cast<double>(a.mant.top_bits(shift));
+  res = std::ldexp(res, static_cast<int>(std::max<int64_t>(std::min<int64_t>(a.exp, 1 << 20), -(1 << 20))));
+  return a.mant.sign ? -res : res;
+}
+
+void big_float::assign(bool negative, big_integer m, int64_t e, bool sticky) {
+  size_t n = bits(m);
+  if (n > prec) {
+    size_t drop = n - prec;
+    bool half = bit(m, drop - 1);
+    sticky = sticky || any_below(m, drop - 1);
+    m >>= static_cast<int>(drop);
+    e += static_cast<int64_t>(drop);
+    if (half && (sticky || bit(m, 0))) {
+      m += 1;
+    }
+  }
+  if (m.is_zero()) {
+    mant = 0;
+    exp = 0;
+    return;
+  }
+  size_t zeros = trailing_zeros(m);
+  m >>= static_cast<int>(zeros);
+  m.sign = negative;
+  mant = std::move(m);
+  exp = e + static_cast<int64_t>(zeros);
+}
+
+// the smaller operand, when it lies entirely below the last bit that can decide the rounding, is replaced by
+// the lowest bit of its sign, so that no more than the precision of the result is ever shifted into place
+big_float big_float::add(big_float const& a, big_float const& b, size_t precision) {
+  big_float res;
+  res.prec = checked(precision);
+  big_float const* x = &a;
+  big_float const* y = &b;
+  if (x->mant.is_zero()) {
+    std::swap(x, y);
+  }
+  if (y->mant.is_zero()) {
+    res.assign(x->mant.sign, magnitude(x->mant), x->exp, false);
+    return res;
+  }
+
+  int64_t tx = x->exp + static_cast<int64_t>(bits(x->mant));
+  int64_t ty = y->exp + static_cast<int64_t>(bits(y->mant));
+  if (tx < ty) {
+    std::swap(x, y);
+    std::swap(tx, ty);
+  }
+  int64_t window = static_cast<int64_t>(std::max(res.prec + 2, bits(x->mant)));
+  big_integer ym = y->mant;
+  int64_t ye = y->exp;
+  if (ty < tx - window - 1) {
+    ym = y->mant.sign ? -1 : 1;
+    ye = tx - window - 2;
+  }
+
+  int64_t e = std::min(x->exp, ye);
+  big_integer sum = (x->mant << static_cast<int>(x->exp - e)) + (ym << static_cast<int>(ye - e));
+  res.assign(sum.sign, magnitude(sum), e, false);
+  return res;
+}
+
+big_float big_float::sub(big_float const& a, big_float const& b, size_t precision) {
+  return add(a, -b, precision);
+}
+
+big_float big_float::mul(big_float const& a, big_float const& b, size_t precision) {
+  big_float res;
+  res.prec = checked(precision);
+  res.assign(a.mant.sign != b.mant.sign, magnitude(a.mant) * magnitude(b.mant), a.exp + b.exp, false);
+  return res;
+}
+
+// floor(a * 2^s / b) with at least precision + 2 bits, the remainder tells the rounding what was cut off
+big_float big_float::div(big_float const& a, big_float const& b, size_t precision) {
+  if (b.mant.is_zero()) {
+    throw std::domain_error("big_float division by zero");
+  }
+  big_float res;
+  res.prec = checked(precision);
+  if (a.mant.is_zero()) {
+    return res;
+  }
+
+  big_integer ma = magnitude(a.mant), mb = magnitude(b.mant);
+  int64_t s = std::max<int64_t>(static_cast<int64_t>(res.prec + 3 + bits(mb)) - static_cast<int64_t>(bits(ma)), 0);
+  big_integer n = ma << static_cast<int>(s);
+  big_integer q = quotient(n, mb);
+  big_integer r = n - q * mb;
+  while (r.sign) {
+    q -= 1;
+    r += mb;
+  }
+  while (r >= mb) {
+    q += 1;
+    r -= mb;
+  }
+  res.assign(a.mant.sign != b.mant.sign, q, a.exp - b.exp - s, !r.is_zero());
+  return res;
+}
+
+// floor(sqrt(m * 4^t)) with at least precision + 2 bits, corrected against the exact remainder
+big_float big_float::sqrt(big_float const& a, size_t precision) {
+  if (a.mant.sign) {
+    throw std::domain_error("square root of negative number");
+  }
+  big_float res;
+  res.prec = checked(precision);
+  if (a.mant.is_zero()) {
+    return res;
+  }
+
+  big_integer m = a.mant;
+  int64_t e = a.exp;
+  if (e & 1) {
+    m <<= 1;
+    e -= 1;
+  }
+  int64_t t = std::max<int64_t>(static_cast<int64_t>(res.prec + 3) - static_cast<int64_t>(bits(m) / 2), 0);
+  m <<= static_cast<int>(2 * t);
+
+  big_integer r;
+  size_t n = bits(m);
+  if (n <= 2 * NEWTON_BASECASE_BITS) {
+    r = isqrt(m);
+  } else {
+    size_t half = (n + (n & 1)) / 2, p = half + GUARD_BITS, k = half - 2;
+    r = ((m >> static_cast<int>(k)) * inverse_sqrt(m, p)) >> static_cast<int>(p + half - k);
+  }
+  big_integer diff = m - r * r;
+  while (diff.sign) {
+    diff += (r << 1) - 1;
+    r -= 1;
+  }
+  while (diff > (r << 1)) {
+    diff -= (r << 1) + 1;
+    r += 1;
+  }
+  res.assign(false, r, (e - 2 * t) / 2, !diff.is_zero());
+  return res;
+}
+
+big_float& big_float::operator+=(big_float const& a) {
+  return *this = *this + a;
+}
+
+big_float& big_float::operator-=(big_float const& a) {
+  return *this = *this - a;
+}
+
+big_float& big_float::operator*=(big_float const& a) {
+  return *this = *this * a;
+}
+
+big_float& big_float::operator/=(big_float const& a) {
+  return *this = *this / a;
+}
+
+big_float big_float::operator+() const {
+  return *this;
+}
+
+big_float big_float::operator-() const {
+  big_float res(*this);
+  res.mant = -res.mant;
+  return res;
+}
+
+int32_t big_float::compare(big_float const& b) const {
+  int32_t sa = mant.sign ? -1 : !mant.is_zero();
+  int32_t sb = b.mant.sign ? -1 : !b.mant.is_zero();
+  if (sa != sb || sa == 0) {
+    return sa < sb ? -1 : sa > sb;
+  }
+  int64_t ta = exp + static_cast<int64_t>(bits(mant));
+  int64_t tb = b.exp + static_cast<int64_t>(bits(b.mant));
+  if (ta != tb) {
+    return ta < tb ? -sa : sa;
+  }
+  int64_t e = std::min(exp, b.exp);
+  big_integer x = magnitude(mant) << static_cast<int>(exp - e);
+  big_integer y = magnitude(b.mant) << static_cast<int>(b.exp - e);
+  return x < y ? -sa : x > y ? sa : 0;
+}
+
+size_t big_float::bits(big_integer const& a) {
+  return a.bit_length();
+}
+
+bool big_float::bit(big_integer const& a, size_t i) {
+  return i / 32 < a.size() && ((a[i / 32] >> (i % 32)) & 1);
+}
+
+bool big_float::any_below(big_integer const& a, size_t i) {
+  size_t limb = std::min(i / 32, a.size());
+  for (size_t j = 0; j != limb; ++j) {
+    if (a[j] != 0) {
+      return true;
+    }
+  }
+  return limb < a.size() && (a[limb] & ((uint32_t(1) << (i % 32)) - 1)) != 0;
+}
+
+size_t big_float::trailing_zeros(big_integer const& a) {
+  size_t res = 0, i = 0;
+  for (; a[i] == 0; ++i) {
+    res += 32;
+  }
+  for (uint32_t x = a[i]; !(x & 1); x >>= 1) {
+    res++;
+  }
+  return res;
+}
+
+big_integer big_float::magnitude(big_integer const& a) {
+  big_integer res(a);
+  res.sign = false;
+  return res;
+}
+
+// about 2^(n + p) / d for d of n bits, a few units off; only the top p + GUARD_BITS bits of d take part
+big_integer big_float::reciprocal(big_integer const& d, size_t p) {
+  size_t n = bits(d), m = std::min(n, p + GUARD_BITS);
+  big_integer dt = d >> static_cast<int>(n - m);
+  if (p <= NEWTON_BASECASE_BITS) {
+    return (big_integer(1) << static_cast<int>(m + p)) / dt;
+  }
+
+  // y + y * (1 - dt * y) with y of half the precision
+  size_t h = p / 2 + GUARD_BITS;
+  big_integer y = reciprocal(dt, h);
+  big_integer e = (big_integer(1) << static_cast<int>(m + h)) - dt * y;
+  return (y << static_cast<int>(p - h)) + ((y * e) >> static_cast<int>(m + 2 * h - p));
+}
+
+// about 2^(p + e / 2) / sqrt(d) for d of n bits and e = n rounded up to even, a few units off
+big_integer big_float::inverse_sqrt(big_integer const& d, size_t p) {
+  size_t n = bits(d), ne = n + (n & 1);
+  size_t shift = n > p + GUARD_BITS ? n - p - GUARD_BITS : 0;
+  shift -= shift & 1;
+  big_integer dt = d >> static_cast<int>(shift);
+  size_t et = ne - shift;
+  if (p <= NEWTON_BASECASE_BITS) {
+    return isqrt((big_integer(1) << static_cast<int>(2 * p + et)) / dt);
+  }
+
+  // y + y * (1 - dt * y^2) / 2 with y of half the precision
+  size_t h = p / 2 + GUARD_BITS;
+  big_integer y = inverse_sqrt(dt, h);
+  big_integer e = (big_integer(1) << static_cast<int>(et + 2 * h)) - dt * y * y;
+  return (y << static_cast<int>(p - h)) + ((y * e) >> static_cast<int>(et + 3 * h + 1 - p));
+}
+
+// floor(a / d) up to a few units, through the reciprocal of d when both the quotient and d are long
+big_integer big_float::quotient(big_integer const& a, big_integer const& d) {
+  size_t la = bits(a), ld = bits(d);
+  if (la < ld) {
+    return 0;
+  }
+  size_t qbits = la - ld + 1;
+  if (qbits <= NEWTON_BASECASE_BITS || ld <= NEWTON_BASECASE_BITS) {
+    return a / d;
+  }
+  size_t p = qbits + GUARD_BITS, k = ld - 2;
+  return ((a >> static_cast<int>(k)) * reciprocal(d, p)) >> static_cast<int>(ld + p - k);
+}
+
+std::string to_string(big_float const& a, size_t digits) {
+  if (digits == 0) {
+    digits = a.prec * 30103 / 100000 + 1;
+  }
+  if (a.mant == 0) {
+    return "0";
+  }
+
+  // s holds the digits of round(|a| * 10^(digits - 1 - e10)), the first of them is at 10^e10
+  big_integer m = big_float::magnitude(a.mant);
+  int64_t top = a.exp + static_cast<int64_t>(big_float::bits(m));
+  int64_t e10 = static_cast<int64_t>(std::floor(static_cast<double>(top - 1) * 0.301029995663981));
+  std::string s;
+  for (;;) {
+    int64_t q = static_cast<int64_t>(digits) - 1 - e10;
+    big_integer num = m, den = 1;
+    if (q >= 0) {
+      num *= pow(big_integer(10), q);
+    } else {
+      den = pow(big_integer(10), -q);
+    }
+    if (a.exp >= 0) {
+      num <<= static_cast<int>(a.exp);
+    } else {
+      den <<= static_cast<int>(-a.exp);
+    }
+    s = to_string(((num << 1) + den) / (den << 1));
+    if (s.size() == digits) {
+      break;
+    }
+    e10 += s.size() > digits ? 1 : -1;
+  }
+  while (s.size() > 1 && s.back() == '0') {
+    s.pop_back();
+  }
+
+  std::string res = a.mant.sign ? "-" : "";
+  if (e10 >= 0 && e10 < static_cast<int64_t>(digits)) {
+    size_t whole = static_cast<size_t>(e10) + 1;
+    res += s.size() <= whole ? s + std::string(whole - s.size(), '0') : s.substr(0, whole) + "." + s.substr(whole);
+  } else if (e10 < 0 && e10 >= -5) {
+    res += "0." + std::string(static_cast<size_t>(-e10 - 1), '0') + s;
+  } else {
+    res += s.substr(0, 1) + (s.size() > 1 ? "." + s.substr(1) : "") + "e" + std::to_string(e10);
+  }
+  return res;
+}
+
+std::string to_string(big_float const& a) {
+  return to_string(a, 0);
+}
@@ -0,0 +1,124 @@
+#ifndef BIGINT__BIG_FLOAT_H_
+#define BIGINT__BIG_FLOAT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "big_integer.h"
+
+// Binary floating point mantissa * 2^exponent with a big_integer mantissa of at most precision bits, kept odd so
+// that every value has one representation. Results are rounded to nearest, ties to even, and get the larger
+// precision of the operands; the static functions take the precision of the result. Division and square root
+// refine a reciprocal and an inverse square root with Newton steps made of multiplications, each step only as
+// precise as it needs to be, and correct the last bit against the exact remainder.
+struct big_float {
+  static constexpr size_t DEFAULT_PRECISION = 256;
+
+  big_float();
+  big_float(int a, size_t precision = DEFAULT_PRECISION);
+  explicit big_float(double a, size_t precision = DEFAULT_PRECISION);
+  explicit big_float(big_integer const& a, size_t precision = DEFAULT_PRECISION);
+  // mantissa * 2^exponent
+  big_float(big_integer const& mantissa, int64_t exponent, size_t precision);
+  big_float(big_float const& a, size_t precision);
+  // decimal "-12.5e-3"
+  explicit big_float(std::string const& str, size_t precision = DEFAULT_PRECISION);
+
+  big_integer const& mantissa() const;
+  int64_t exponent() const;
+  size_t precision() const;
+  // 2^(exponent of the top bit + 1 - precision), 2^-precision for zero
+  big_float ulp() const;
+
+  // rounded toward zero
+  big_integer to_big_integer() const;
+  // rounded to 53 bits first
+  double to_double() const;
+
+  static big_float add(big_float const& a, big_float const& b, size_t precision);
+  static big_float sub(big_float const& a, big_float const& b, size_t precision);
+  static big_float mul(big_float const& a, big_float const& b, size_t precision);
+  static big_float div(big_float const& a, big_float const& b, size_t precision);
+  static big_float sqrt(big_float const& a, size_t precision);
+
+  big_float& operator+=(big_float const& a);
+  big_float& operator-=(big_float const& a);
+  big_float& operator*=(big_float const& a);
+  big_float& operator/=(big_float const& a);
+
+  big_float operator+() const;
+  big_float operator-() const;
+
+  friend big_float operator+(big_float const& a, big_float const& b) {
+    return add(a, b, std::max(a.prec, b.prec));
+  }
+
+  friend big_float operator-(big_float const& a, big_float const& b) {
+    return sub(a, b, std::max(a.prec, b.prec));
+  }
+
+  friend big_float operator*(big_float const& a, big_float const& b) {
+    return mul(a, b, std::max(a.prec, b.prec));
+  }
+
+  friend big_float operator/(big_float const& a, big_float const& b) {
+    return div(a, b, std::max(a.prec, b.prec));
+  }
+
+  friend big_float sqrt(big_float const& a) {
+    return sqrt(a, a.prec);
+  }
+
+  friend bool operator==(big_float const& a, big_float const& b) {
+    return a.compare(b) == 0;
+  }
+
+  friend bool operator!=(big_float const& a, big_float const& b) {
+    return a.compare(b) != 0;
+  }
+
+  friend bool operator<(big_float const& a, big_float const& b) {
+    return a.compare(b) < 0;
+  }
+
+  friend bool operator>(big_float const& a, big_float const& b) {
+    return a.compare(b) > 0;
+  }
+
+  friend bool operator<=(big_float const& a, big_float const& b) {
+    return a.compare(b) <= 0;
+  }
+
+  friend bool operator>=(big_float const& a, big_float const& b) {
+    return a.compare(b) >= 0;
+  }
+
+  // rounded to digits significant decimal digits without trailing zeros, digits = 0 takes as many as the precision
+  friend std::string to_string(big_float const& a, size_t digits);
+  friend std::string to_string(big_float const& a);
+
+  friend std::ostream& operator<<(std::ostream& s, big_float const& a) {
+    return s << to_string(a);
+  }
+
+ private:
+  big_integer mant;
+  int64_t exp;
+  size_t prec;
+
+  // |m| * 2^e rounded into *this, sticky tells that the exact value is a bit above |m| * 2^e
+  void assign(bool negative, big_integer m, int64_t e, bool sticky);
+  int32_t compare(big_float const& b) const;
+
+  static size_t bits(big_integer const& a);
+  static bool bit(big_integer const& a, size_t i);
+  static bool any_below(big_integer const& a, size_t i);
+  static size_t trailing_zeros(big_integer const& a);
+  static big_integer magnitude(big_integer const& a);
+  static big_integer reciprocal(big_integer const& d, size_t p);
+  static big_integer inverse_sqrt(big_integer const& d, size_t p);
+  static big_integer quotient(big_integer const& a, big_integer const& d);
+};
+
+#endif //BIGINT__BIG_FLOAT_H_
@@ -2,328 +2,689 @@
 // Created by dave11ar on 28.04.2020.
 //
 
-#include "big_integer.h"
+#include "basic_big_integer.h"
+#include "constant_pool.h"
+#include "scratch_arena.h"
 #include <algorithm>
 
-big_integer::big_integer() : sign(false), value(0) {}
+namespace {
+size_t const KARATSUBA_THRESHOLD = 32;
+// below these sizes radix conversion goes limb by limb instead of splitting at a power of ten
+size_t const DIGITS_BASECASE_LIMBS = 32;
+size_t const PARSE_BASECASE_DIGITS = 300;
+uint32_t const DECIMAL_CHUNK = 1000000000;
+
+// res[0, an + bn) = a * b
+void mul_basecase(uint32_t* res, uint32_t const* a, size_t an, uint32_t const* b, size_t bn) {
+  std::fill(res, res + an + bn, 0);
+  for (size_t i = 0; i < an; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < bn; j++) {
+      uint64_t tmp = static_cast<uint64_t>(a[i]) * b[j] + carry + res[i + j];
+      res[i + j] = static_cast<uint32_t>(tmp & UINT32_MAX);
+      carry = tmp >> 32;
+    }
+    res[i + bn] = static_cast<uint32_t>(carry);
+  }
+}
 
-big_integer::big_integer(size_t n) : big_integer() {
-  for (size_t i = 1; i < n; i++) {
-    push_back(0);
+// a[0, n) += b[0, bn), carry is propagated up to a[n - 1]
+void add_to(uint32_t* a, size_t n, uint32_t const* b, size_t bn) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n && (i < bn || carry != 0); i++) {
+    uint64_t tmp = carry + a[i] + (i < bn ? b[i] : 0);
+    a[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
   }
 }
 
-big_integer::big_integer(big_integer const &a) : sign(a.sign), value(a.value) {}
+// a[0, n) -= b[0, bn), a must not be less than b
+void sub_from(uint32_t* a, size_t n, uint32_t const* b, size_t bn) {
+  int64_t borrow = 0;
+  for (size_t i = 0; i < n && (i < bn || borrow != 0); i++) {
+    int64_t tmp = static_cast<int64_t>(a[i]) - (i < bn ? b[i] : 0) - borrow;
+    borrow = tmp < 0;
+    a[i] = static_cast<uint32_t>(tmp < 0 ? tmp + 1 + UINT32_MAX : tmp);
+  }
+}
 
-big_integer::big_integer(int a) : sign(a < 0) ,value(static_cast<uint32_t>(a < 0 ? -static_cast<uint64_t>(a) :  a)) {}
+// res[0, 2n) = a * b, temporaries come from the scratch arena
+void mul_karatsuba(uint32_t* res, uint32_t const* a, uint32_t const* b, size_t n) {
+  if (n < KARATSUBA_THRESHOLD) {
+    mul_basecase(res, a, n, b, n);
+    return;
+  }
 
-big_integer::big_integer(uint32_t a) : sign(false), value(buffer(a)) {}
+  size_t h = n / 2, k = n - h + 1;
+  mul_karatsuba(res, a, b, h);
+  mul_karatsuba(res + 2 * h, a + h, b + h, n - h);
 
-big_integer::big_integer(std::string const &str) : big_integer() {
-  if (str.empty() || str == "0" || str == "-0") {
+  scratch_arena::frame frame;
+  uint32_t* sa = frame.allocate(k);
+  uint32_t* sb = frame.allocate(k);
+  uint32_t* mid = frame.allocate(2 * k);
+  std::copy(a + h, a + n, sa);
+  std::copy(b + h, b + n, sb);
+  sa[k - 1] = sb[k - 1] = 0;
+  add_to(sa, k, a, h);
+  add_to(sb, k, b, h);
+
+  // (a0 + a1)(b0 + b1) - a0 * b0 - a1 * b1
+  mul_karatsuba(mid, sa, sb, k);
+  sub_from(mid, 2 * k, res, 2 * h);
+  sub_from(mid, 2 * k, res + 2 * h, 2 * (n - h));
+  add_to(res + h, 2 * n - h, mid, std::min(2 * k, 2 * n - h));
+}
+
+// res[0, an + bn) = a * b for an >= bn, the longer operand is cut into bn-sized pieces
+void mul_limbs(uint32_t* res, uint32_t const* a, size_t an, uint32_t const* b, size_t bn) {
+  if (bn < KARATSUBA_THRESHOLD) {
+    mul_basecase(res, a, an, b, bn);
+    return;
+  }
+  if (an == bn) {
+    mul_karatsuba(res, a, b, bn);
     return;
   }
 
-  for (size_t digit = (str[0] == '-' || str[0] == '+'); digit < str.length(); digit++) {
-    *this *= 10;
-    *this += (str[digit] - '0');
+  std::fill(res, res + an + bn, 0);
+  scratch_arena::frame frame;
+  uint32_t* tmp = frame.allocate(2 * bn);
+  for (size_t offset = 0; offset < an; offset += bn) {
+    size_t len = std::min(bn, an - offset);
+    if (len == bn) {
+      mul_karatsuba(tmp, a + offset, b, bn);
+    } else {
+      mul_limbs(tmp, b, bn, a + offset, len);
+    }
+    add_to(res + offset, an + bn - offset, tmp, len + bn);
   }
-  if (str[0] == '-') {
-    sign = true;
+}
+
+// estimate of the quotient limb from the top two limbs of a[0, m)
+uint32_t trial(uint32_t const* a, size_t m, uint32_t divider) {
+  uint64_t dividend = (static_cast<uint64_t>(a[m - 1]) << 32) | a[m - 2];
+  return static_cast<uint32_t>(std::min<uint64_t>(dividend / divider, UINT32_MAX));
+}
+
+// whether any of the limbs * 32 + bits lowest bits is set, x has more than limbs limbs
+bool has_low_bits(const_limb_span x, size_t limbs, uint32_t bits) {
+  return (x.data[limbs] & ((static_cast<uint32_t>(1) << bits) - 1)) != 0 ||
+      std::any_of(x.data, x.data + limbs, [](uint32_t limb) { return limb != 0; });
+}
+
+// a[0, m) < b[0, m)
+bool smaller(uint32_t const* a, uint32_t const* b, size_t m) {
+  for (size_t i = m; i != 0; i--) {
+    if (a[i - 1] != b[i - 1]) {
+      return a[i - 1] < b[i - 1];
+    }
   }
-  normalize();
+  return false;
+}
 }
 
-big_integer::~big_integer() = default;
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer() : sign(false), value(0) {}
 
-big_integer& big_integer::operator=(big_integer const &a) {
-  if (a == *this) {
-    return *this;
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(size_t n) : basic_big_integer() {
+  value.resize(n, 0);
+}
+
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(basic_big_integer const &a) : sign(a.sign), value(a.value) {}
+
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(basic_big_integer&& a) noexcept
+    : sign(a.sign), value(std::move(a.value)) {
+  a.sign = false;
+}
+
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(int a) : sign(a < 0) ,value(static_cast<uint32_t>(a < 0 ? -static_cast<uint64_t>(a) :  a)) {}
+
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(uint32_t a) : sign(false), value(a) {}
+
+template<typename Storage>
+basic_big_integer<Storage>::basic_big_integer(std::string const &str) : basic_big_integer() {
+  if (str.empty() || str == "0" || str == "-0") {
+    return;
   }
 
+  size_t first = str[0] == '-' || str[0] == '+';
+  *this = parse_digits(str.data() + first, str.data() + str.size());
+  sign = str[0] == '-';
+  normalize();
+}
+
+template<typename Storage>
+basic_big_integer<Storage>::~basic_big_integer() = default;
+
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator=(basic_big_integer const &a) {
   value = a.value;
   sign = a.sign;
   return *this;
 }
 
-big_integer& big_integer::operator+=(big_integer const &a) {
-  return *this = *this + a;
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator=(basic_big_integer&& a) noexcept {
+  value = std::move(a.value);
+  sign = a.sign;
+  a.sign = false;
+  return *this;
 }
 
-big_integer& big_integer::operator-=(big_integer const &a) {
-  return *this = *this - a;
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator+=(basic_big_integer const &a) {
+  bool a_sign = a.sign;
+  if (sign == a_sign) {
+    add_abs(a);
+  } else if (sub_abs(a)) {
+    sign = a_sign;
+  }
+  normalize();
+  return *this;
 }
 
-big_integer& big_integer::operator*=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator-=(basic_big_integer const &a) {
+  bool a_sign = !a.sign;
+  if (sign == a_sign) {
+    add_abs(a);
+  } else if (sub_abs(a)) {
+    sign = a_sign;
+  }
+  normalize();
+  return *this;
+}
+
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator*=(basic_big_integer const &a) {
   return *this = *this * a;
 }
 
-big_integer& big_integer::operator/=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator/=(basic_big_integer const &a) {
   return *this = (*this / a);
 }
 
-big_integer& big_integer::operator%=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator%=(basic_big_integer const &a) {
   return *this = *this % a;
 }
 
-big_integer& big_integer::operator&=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator&=(basic_big_integer const &a) {
   return *this = *this & a;
 }
 
-big_integer& big_integer::operator|=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator|=(basic_big_integer const &a) {
   return *this = *this | a;
 }
 
-big_integer& big_integer::operator^=(big_integer const &a) {
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator^=(basic_big_integer const &a) {
   return *this = *this ^ a;
 }
 
-big_integer& big_integer::operator<<=(int a) {
-  return *this = *this << a;
+// in place, whole limbs go through the gap in front of the limbs
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator<<=(int a) {
+  if (a < 0) {
+    return *this >>= -a;
+  }
+  if (is_zero()) {
+    return *this;
+  }
+
+  size_t limbs = a / 32;
+  uint32_t bits = a % 32;
+  if (bits != 0) {
+    limb_span x = value.span();
+    uint32_t carry = 0;
+    for (size_t i = 0; i < x.size; i++) {
+      uint32_t cur = x.data[i];
+      x.data[i] = (cur << bits) | carry;
+      carry = cur >> (32 - bits);
+    }
+    if (carry != 0) {
+      push_back(carry);
+    }
+  }
+  if (limbs != 0) {
+    value.insert_front(limbs);
+  }
+  return *this;
 }
 
-big_integer& big_integer::operator>>=(int a) {
-  return *this = *this >> a;
+template<typename Storage>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator>>=(int a) {
+  if (a < 0) {
+    return *this <<= -a;
+  }
+
+  size_t limbs = a / 32;
+  uint32_t bits = a % 32;
+  if (limbs >= size()) {
+    return *this = sign ? -1 : 0;
+  }
+
+  bool inexact = sign && has_low_bits(value.cspan(), limbs, bits);
+  if (limbs != 0) {
+    value.drop_front(limbs);
+  }
+  if (bits != 0) {
+    limb_span x = value.span();
+    for (size_t i = 0; i < x.size; i++) {
+      uint32_t high = i + 1 < x.size ? x.data[i + 1] : 0;
+      x.data[i] = (x.data[i] >> bits) | (high << (32 - bits));
+    }
+  }
+  normalize();
+
+  if (inexact) {
+    *this -= 1;
+  }
+  return *this;
 }
 
-big_integer big_integer::operator+() const {
-  return big_integer(*this);
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator+() const {
+  return basic_big_integer(*this);
 }
 
-big_integer big_integer::operator-() const {
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator-() const {
   if (size() == 1 && !(*this)[0]) {
     return *this;
   }
 
-  big_integer tmp(*this);
+  basic_big_integer tmp(*this);
   tmp.sign = !tmp.sign;
   tmp.normalize();
   return tmp;
 }
 
-big_integer big_integer::operator~() const {
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator~() const {
   return -(*this) - 1;
 }
 
-big_integer &big_integer::operator++() {
-  return *this += 1;
+template<typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator++() {
+  return *this += constant_pool<basic_big_integer>::small(1);
 }
 
-big_integer big_integer::operator++(int) {
-  big_integer r = *this;
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator++(int) {
+  basic_big_integer r = *this;
   ++*this;
   return r;
 }
 
-big_integer &big_integer::operator--() {
-  return *this -= 1;
+template<typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator--() {
+  return *this -= constant_pool<basic_big_integer>::small(1);
 }
 
-big_integer big_integer::operator--(int) {
-  big_integer r = *this;
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator--(int) {
+  basic_big_integer r = *this;
   --*this;
   return r;
 }
 
-big_integer operator+(big_integer a, big_integer const& b) {
-  if (a.sign == b.sign) {
-    uint64_t tmp, carry = 0;
+template<typename Storage>
+void basic_big_integer<Storage>::reserve(size_t n) {
+  value.reserve(n);
+}
 
-    size_t max_size = std::max(a.size(), b.size());
-    for (size_t i = 0; i < max_size; i++) {
-      if (i == a.size()) a[0];
-      tmp = carry + a[i] + (i < b.size() ? b[i] : 0);
-      carry = tmp > UINT32_MAX;
-      a[i] = (uint32_t) (tmp & UINT32_MAX);
-    }
-    if (carry > 0) {
-      a.push_back(carry);
-    }
+template<typename Storage>
+size_t basic_big_integer<Storage>::capacity() const {
+  return value.capacity();
+}
 
-    a.normalize();
-    return a;
-  } else {
-    return (a.sign ? b - (-a) : a - (-b));
+// |*this| += |b|
+template<typename Storage>
+void basic_big_integer<Storage>::add_abs(basic_big_integer const& b) {
+  size_t old_size = size(), b_size = b.size();
+  if (old_size < b_size) {
+    value.resize(b_size, 0);
   }
-}
+  limb_span x = value.span();
+  const_limb_span y = b.value.span();
 
-big_integer operator-(big_integer a, big_integer const& b) {
-  if (a == 0) {
-    return -b;
+  uint64_t carry = 0;
+  size_t i = 0;
+  for (; i < y.size; i++) {
+    uint64_t tmp = carry + x.data[i] + y.data[i];
+    x.data[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
   }
-  if (b == 0) {
-    return a;
+  for (; i < x.size && carry != 0; i++) {
+    uint64_t tmp = carry + x.data[i];
+    x.data[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
   }
-
-  if (a.sign != b.sign) {
-    return (a.sign ? -(-a + b) : a + -b);
+  if (carry > 0) {
+    push_back(static_cast<uint32_t>(carry));
   }
-  if (a.sign) {
-    return (-b - (-a));
+}
+
+// |*this| = ||*this| - |b||, returns whether |b| was greater
+template<typename Storage>
+bool basic_big_integer<Storage>::sub_abs(basic_big_integer const& b) {
+  size_t b_size = b.size();
+  bool swapped = compare_abs(b) < 0;
+  if (swapped) {
+    value.resize(b_size, 0);
   }
-  if (a < b) {
-    return -(b - a);
+  limb_span x = value.span();
+  const_limb_span y = b.value.span();
+
+  int64_t borrow = 0;
+  for (size_t i = 0; i < x.size; i++) {
+    if (i >= b_size && borrow == 0) {
+      break;
+    }
+    int64_t yi = i < b_size ? y.data[i] : 0;
+    int64_t tmp = swapped ? yi - x.data[i] - borrow : static_cast<int64_t>(x.data[i]) - yi - borrow;
+    borrow = tmp < 0;
+    x.data[i] = static_cast<uint32_t>(tmp < 0 ? tmp + 1 + UINT32_MAX : tmp);
   }
-  // a >= b > 0;
+  return swapped;
+}
 
-  a.sign = false;
-  uint32_t carry = 0;
-  int64_t tmp;
-  for (size_t i = 0; i < a.size(); i++) {
-    tmp = (int64_t) a[i] - carry - (i < b.size() ? b[i] : 0);
-    carry = tmp < 0;
-    a[i] = tmp < 0 ? static_cast<uint32_t>(tmp + 1 + UINT32_MAX) : tmp;
+template<typename Storage>
+void basic_big_integer<Storage>::mul_to(basic_big_integer& res, basic_big_integer const& a,
+                                        basic_big_integer const& b) {
+  if (&res == &a || &res == &b) {
+    basic_big_integer tmp;
+    mul_to(tmp, a, b);
+    res = std::move(tmp);
+    return;
   }
-  a.normalize();
 
-  return a;
+  res.value.resize(a.size() + b.size());
+  uint32_t* r = res.value.span().data;
+  const_limb_span x = a.value.span(), y = b.value.span();
+  if (x.size >= y.size) {
+    mul_limbs(r, x.data, x.size, y.data, y.size);
+  } else {
+    mul_limbs(r, y.data, y.size, x.data, x.size);
+  }
+  res.sign = a.sign ^ b.sign;
+  res.normalize();
 }
 
-big_integer operator*(big_integer a, big_integer const& b){
-  if (a == 0 || b == 0) {
-    return 0;
+// *this += (negate ? -a * b : a * b) without building the product
+template<typename Storage>
+void basic_big_integer<Storage>::add_mul(basic_big_integer const& a, basic_big_integer const& b, bool negate) {
+  if (this == &a || this == &b) {
+    basic_big_integer p;
+    mul_to(p, a, b);
+    p.sign ^= negate;
+    *this += p;
+    return;
+  }
+  if (a.is_zero() || b.is_zero()) {
+    return;
   }
 
-  big_integer res(a.size() + b.size());
+  bool p_sign = a.sign ^ b.sign ^ negate;
+  if (is_zero()) {
+    sign = p_sign;
+  }
 
-  res.sign = a.sign ^ b.sign;
-  for (size_t i = 0; i < a.size(); i++) {
+  size_t old_size = size(), n = std::max(old_size, a.size() + b.size()) + 1;
+  value.resize(n, 0);
+  limb_span r = value.span();
+  const_limb_span x = a.value.span(), y = b.value.span();
+
+  bool wrapped = false;
+  for (size_t i = 0; i < x.size; i++) {
     uint64_t carry = 0;
-    for (size_t j = 0; j < b.size(); j++) {
-      uint64_t tmp = (uint64_t) a[i] * b[j] + carry + res[i + j];
-      res[i + j] = static_cast<uint32_t>(tmp & UINT32_MAX);
-      carry = tmp >> 32;
+    if (sign == p_sign) {
+      for (size_t j = 0; j < y.size; j++) {
+        uint64_t tmp = static_cast<uint64_t>(x.data[i]) * y.data[j] + carry + r.data[i + j];
+        r.data[i + j] = static_cast<uint32_t>(tmp & UINT32_MAX);
+        carry = tmp >> 32;
+      }
+      for (size_t k = i + y.size; carry != 0; k++) {
+        uint64_t tmp = carry + r.data[k];
+        r.data[k] = static_cast<uint32_t>(tmp & UINT32_MAX);
+        carry = tmp >> 32;
+      }
+    } else {
+      int64_t borrow = 0;
+      for (size_t j = 0; j < y.size; j++) {
+        uint64_t tmp = static_cast<uint64_t>(x.data[i]) * y.data[j] + carry;
+        carry = tmp >> 32;
+        int64_t diff = static_cast<int64_t>(r.data[i + j]) - static_cast<int64_t>(tmp & UINT32_MAX) - borrow;
+        borrow = diff < 0;
+        r.data[i + j] = static_cast<uint32_t>(diff < 0 ? diff + 1 + UINT32_MAX : diff);
+      }
+      uint64_t pending = carry + borrow;
+      for (size_t k = i + y.size; pending != 0; k++) {
+        if (k == n) {
+          wrapped = true;
+          break;
+        }
+        int64_t diff = static_cast<int64_t>(r.data[k]) - static_cast<int64_t>(pending);
+        pending = diff < 0;
+        r.data[k] = static_cast<uint32_t>(diff < 0 ? diff + 1 + UINT32_MAX : diff);
+      }
     }
-    res[i + b.size()] += carry;
   }
-  res.normalize();
 
-  return res;
+  if (wrapped) {
+    // |a * b| was greater, the limbs hold 2^(32n) - (|a * b| - |*this|)
+    uint64_t carry = 1;
+    for (size_t i = 0; i < n; i++) {
+      uint64_t tmp = static_cast<uint64_t>(UINT32_MAX - r.data[i]) + carry;
+      r.data[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+      carry = tmp >> 32;
+    }
+    sign = p_sign;
+  }
+  normalize();
 }
 
-uint32_t big_integer::short_div(uint32_t b) {
+template<typename Storage>
+void basic_big_integer<Storage>::mul_short(uint32_t b) {
+  limb_span x = value.span();
   uint64_t carry = 0;
-  for (size_t i = size(); i != 0; i--) {
-    uint64_t tmp = (carry << 32) + (*this)[i - 1];
-    (*this)[i - 1] = tmp / b;
-    carry = tmp % b;
+  for (size_t i = 0; i < x.size; i++) {
+    uint64_t tmp = static_cast<uint64_t>(x.data[i]) * b + carry;
+    x.data[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
+  }
+  if (carry != 0) {
+    push_back(static_cast<uint32_t>(carry));
   }
   normalize();
-
-  return carry;
 }
 
-uint32_t big_integer::trial(big_integer const &b) {
-  uint64_t dividend = (static_cast<uint64_t>((*this)[size() - 1]) << 32) |
-      (static_cast<uint64_t>((*this)[size() - 2]));
-  uint64_t divider = static_cast<uint64_t>(b.back());
+template<typename Storage>
+void basic_big_integer<Storage>::copy_from(basic_big_integer const& a) {
+  if (this == &a) {
+    return;
+  }
+  value.resize(a.size());
+  const_limb_span x = a.value.span();
+  std::copy(x.data, x.data + x.size, value.span().data);
+  sign = a.sign;
+}
 
-  return (dividend / divider) & UINT32_MAX;
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::square() const {
+  basic_big_integer res;
+  square_to(res, *this);
+  return res;
 }
 
-bool big_integer::smaller(big_integer const& b, size_t m) {
-  for (size_t i = 1; i <= size(); i++) {
-    uint32_t x = (*this)[size() - i];
-    uint32_t y = (m - i < b.size() ? b[m - i] : 0);
-    if (x != y) {
-      return x < y;
+// every cross product a[i] * a[j] is computed once and doubled; res keeps its capacity
+template<typename Storage>
+void basic_big_integer<Storage>::square_to(basic_big_integer& res, basic_big_integer const& a) {
+  if (&res == &a) {
+    basic_big_integer tmp;
+    square_to(tmp, a);
+    res = std::move(tmp);
+    return;
+  }
+  size_t n = a.size();
+  if (n >= KARATSUBA_THRESHOLD) {
+    mul_to(res, a, a);
+    return;
+  }
+  res.value.resize(2 * n);
+  limb_span r = res.value.span();
+  std::fill(r.data, r.data + r.size, 0);
+  const_limb_span x = a.value.span();
+
+  for (size_t i = 0; i < n; i++) {
+    uint64_t carry = 0;
+    for (size_t j = i + 1; j < n; j++) {
+      uint64_t tmp = static_cast<uint64_t>(x.data[i]) * x.data[j] + carry + r.data[i + j];
+      r.data[i + j] = static_cast<uint32_t>(tmp & UINT32_MAX);
+      carry = tmp >> 32;
     }
+    r.data[i + n] = static_cast<uint32_t>(carry);
   }
-  return false;
+
+  uint32_t top = 0;
+  for (size_t i = 0; i < 2 * n; i++) {
+    uint32_t cur = r.data[i];
+    r.data[i] = (cur << 1) | top;
+    top = cur >> 31;
+  }
+
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t sq = static_cast<uint64_t>(x.data[i]) * x.data[i];
+    uint64_t tmp = carry + r.data[2 * i] + (sq & UINT32_MAX);
+    r.data[2 * i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    tmp = (tmp >> 32) + r.data[2 * i + 1] + (sq >> 32);
+    r.data[2 * i + 1] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
+  }
+  res.sign = false;
+  res.normalize();
 }
 
-void big_integer::difference(big_integer const &b, size_t m) {
-  int64_t borrow = 0;
-  uint64_t start = size() - m;
-  for (size_t i = 0; i < m; i++) {
-    int64_t diff = static_cast<int64_t>((*this)[start + i]) - (i < b.size() ? b[i] : 0) - borrow;
-    (*this)[start + i] = (diff < 0 ? static_cast<uint32_t>(diff + 1 + UINT32_MAX) : diff);
-    borrow = diff < 0;
+template<typename Storage>
+uint32_t basic_big_integer<Storage>::short_div(uint32_t b) {
+  limb_span x = value.span();
+  uint64_t carry = 0;
+  for (size_t i = x.size; i != 0; i--) {
+    uint64_t tmp = (carry << 32) + x.data[i - 1];
+    x.data[i - 1] = tmp / b;
+    carry = tmp % b;
   }
+  normalize();
+
+  return carry;
 }
 
-std::pair<big_integer, big_integer> big_integer::div_mod(big_integer const &b) {
-  bool ans_sign = sign ^ b.sign;
+// *this becomes the remainder, the quotient goes to q
+template<typename Storage>
+void basic_big_integer<Storage>::div_mod(basic_big_integer const& b, basic_big_integer& q) {
+  bool q_sign = sign ^ b.sign;
   bool this_sign = sign;
 
-  sign = b.sign;
-  if ((!b.sign && b > *this) || (b.sign && b < *this)) {
-    sign = this_sign;
-    this->normalize();
-    return {0, *this};
+  if (compare_abs(b) < 0) {
+    q.value.resize(1);
+    q[0] = 0;
+    q.sign = false;
+    return;
   }
 
   if (b.size() == 1) {
-    big_integer sh = short_div(b[0]);
-    sign = ans_sign;
-    sh.sign = this_sign;
+    q.copy_from(*this);
+    uint32_t rem = q.short_div(b[0]);
+    q.sign = q_sign;
+    q.normalize();
 
-    this->normalize();
-    sh.normalize();
-
-    return {*this, sh};
+    value.resize(1);
+    (*this)[0] = rem;
+    sign = this_sign;
+    normalize();
+    return;
   }
 
   uint32_t normalize_shift = (static_cast<uint64_t>(UINT32_MAX) + 1) / (static_cast<uint64_t>(b.back()) + 1);
-  *this *= normalize_shift;
-  big_integer divider(b * normalize_shift);
+  value.reserve(size() + 2);
+  mul_short(normalize_shift);
   push_back(0);
-  size_t m = divider.size() + 1;
-  big_integer ans(size() - divider.size()), dq;
-  uint32_t qt = 0;
 
-  for (size_t j = ans.size(); j != 0; j--) {
-    qt = trial(divider);
-    dq = divider * qt;
+  // the normalized divider keeps the length of b, dq = divider * qt needs one more limb
+  scratch_arena::frame frame;
+  size_t n = b.size(), m = n + 1;
+  uint32_t* divider = frame.allocate(n);
+  uint32_t* dq = frame.allocate(m);
+  const_limb_span d = b.value.span();
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t tmp = static_cast<uint64_t>(d.data[i]) * normalize_shift + carry;
+    divider[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+    carry = tmp >> 32;
+  }
+
+  q.value.resize(size() - n);
+  limb_span r = value.span(), qs = q.value.span();
+  for (size_t j = qs.size; j != 0; j--) {
+    // the dividend window r[j - 1, j + n) shrinks by one limb from the top every step
+    uint32_t* window = r.data + j - 1;
+    uint32_t qt = trial(window, m, divider[n - 1]);
+    carry = 0;
+    for (size_t i = 0; i < n; i++) {
+      uint64_t tmp = static_cast<uint64_t>(divider[i]) * qt + carry;
+      dq[i] = static_cast<uint32_t>(tmp & UINT32_MAX);
+      carry = tmp >> 32;
+    }
+    dq[n] = static_cast<uint32_t>(carry);
 
-    while (smaller(dq, m)) {
+    while (smaller(window, dq, m)) {
       qt--;
-      dq -= divider;
+      sub_from(dq, m, divider, n);
     }
-    ans[j - 1] = qt;
-
-    difference(dq, m);
-    pop_back();
+    qs.data[j - 1] = qt;
+    sub_from(window, m, dq, m);
   }
+  value.resize(n);
 
-  ans.sign = ans_sign;
-  ans.normalize();
+  q.sign = q_sign;
+  q.normalize();
 
   sign = this_sign;
-  this->short_div(normalize_shift);
-  this->normalize();
-
-  return {ans, *this};
-}
-
-big_integer operator/(big_integer a, big_integer const& b) {
-  return a.div_mod(b).first;
-}
-
-big_integer operator%(big_integer a, big_integer const& b) {
-  return a.div_mod(b).second;
+  short_div(normalize_shift);
+  normalize();
 }
 
-void big_integer::additional_code() {
-  for (size_t i = 0; i < size(); i++){
-    (*this)[i] = UINT32_MAX - (*this)[i];
+template<typename Storage>
+void basic_big_integer<Storage>::additional_code() {
+  limb_span x = value.span();
+  for (size_t i = 0; i < x.size; i++){
+    x.data[i] = UINT32_MAX - x.data[i];
   }
 
   sign = false;
   *this += 1;
 }
 
-big_integer big_integer::binary_operation(big_integer const& b, const std::function<uint32_t(uint32_t, uint32_t)>& func) {
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::binary_operation(
+    basic_big_integer const& b, const std::function<uint32_t(uint32_t, uint32_t)>& func) const {
   uint32_t new_sign = func(sign, b.sign);
 
-  big_integer fir(*this), sec(b);
-
-  while (fir.size() < sec.size()) {
-    fir.push_back(0);
-  }
-  while (sec.size() < fir.size()) {
-    sec.push_back(0);
-  }
+  basic_big_integer fir(*this), sec(b);
+  size_t n = std::max(fir.size(), sec.size());
+  fir.value.resize(n, 0);
+  sec.value.resize(n, 0);
   if (fir.sign) {
     fir.additional_code();
   }
@@ -331,8 +692,10 @@ big_integer big_integer::binary_operation(big_integer const& b, const std::funct
     sec.additional_code();
   }
 
-  for (size_t i = 0; i < fir.size(); i++) {
-    fir[i] = func(fir[i], sec[i]);
+  limb_span x = fir.value.span();
+  const_limb_span y = sec.value.cspan();
+  for (size_t i = 0; i < x.size; i++) {
+    x.data[i] = func(x.data[i], y.data[i]);
   }
   fir.normalize();
 
@@ -345,54 +708,59 @@ big_integer big_integer::binary_operation(big_integer const& b, const std::funct
   return fir;
 }
 
-big_integer operator&(big_integer a, big_integer const& b) {
-  return a.binary_operation(b, [] (uint32_t a, uint32_t b) { return a & b; });
-}
-big_integer operator|(big_integer a, big_integer const& b) {
-  return a.binary_operation(b, [] (uint32_t a, uint32_t b) { return a | b; });
-}
-big_integer operator^(big_integer a, big_integer const& b) {
-  return a.binary_operation(b,[] (uint32_t a, uint32_t b) { return a ^ b; });
-}
-
-big_integer operator<<(big_integer a, int b) {
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::shift_left(basic_big_integer const& a, int b) {
   if (b < 0) {
     return a >> (-b);
   }
 
-  a *= (static_cast<uint32_t>(1) << (b % 32));
-
-  uint32_t tmp = b / 32;
-
-  a.reverse();
-  for (size_t i = 0; i < tmp; i++) {
-    a.push_back(0);
+  size_t limbs = b / 32;
+  uint32_t bits = b % 32;
+  const_limb_span x = a.value.cspan();
+  basic_big_integer res(x.size + limbs + 1);
+  limb_span r = res.value.span();
+  for (size_t i = 0; i < x.size; i++) {
+    r.data[i + limbs] |= x.data[i] << bits;
+    if (bits != 0) {
+      r.data[i + limbs + 1] = x.data[i] >> (32 - bits);
+    }
   }
-  a.reverse();
 
-  a.normalize();
-  return a;
+  res.sign = a.sign;
+  res.normalize();
+  return res;
 }
 
-big_integer operator>>(big_integer a, int b) {
+// rounds towards minus infinity
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::shift_right(basic_big_integer const& a, int b) {
   if (b < 0) {
     return a << (-b);
   }
 
-  a /= (static_cast<uint32_t>(1) << (b % 32));
-
-  uint32_t tmp = b / 32;
+  size_t limbs = b / 32;
+  uint32_t bits = b % 32;
+  const_limb_span x = a.value.cspan();
+  if (limbs >= x.size) {
+    return a.sign ? -1 : 0;
+  }
 
-  a.reverse();
-  for (size_t i = 0; i < tmp; i++) {
-    a.pop_back();
+  basic_big_integer res(x.size - limbs);
+  limb_span r = res.value.span();
+  for (size_t i = 0; i < r.size; i++) {
+    uint32_t high = i + limbs + 1 < x.size ? x.data[i + limbs + 1] : 0;
+    r.data[i] = bits == 0 ? x.data[i + limbs] : (x.data[i + limbs] >> bits) | (high << (32 - bits));
   }
-  a.reverse();
+  res.sign = a.sign;
+  res.normalize();
 
-  a.normalize();
-  return a.sign ? a - 1 : a;
+  if (a.sign && has_low_bits(x, limbs, bits)) {
+    res -= 1;
+  }
+  return res;
 }
-int32_t big_integer::compare(big_integer const& b) const {
+template<typename Storage>
+int32_t basic_big_integer<Storage>::compare(basic_big_integer const& b) const {
   if (sign != b.sign) {
     return sign ? -1 : 1;
   }
@@ -404,11 +772,12 @@ int32_t big_integer::compare(big_integer const& b) const {
     return sign ? 1 : -1;
   }
 
-  for (size_t i = size(); i > 0; i--) {
-    if (value[i - 1] > b[i - 1]) {
+  const_limb_span x = value.span(), y = b.value.span();
+  for (size_t i = x.size; i > 0; i--) {
+    if (x.data[i - 1] > y.data[i - 1]) {
       return sign ? -1 : 1;
     }
-    if (value[i - 1] < b[i - 1]) {
+    if (x.data[i - 1] < y.data[i - 1]) {
       return sign ? 1 : -1;
     }
   }
@@ -416,54 +785,109 @@ int32_t big_integer::compare(big_integer const& b) const {
   return 0;
 }
 
-bool operator==(big_integer const &a, big_integer const &b) {
-  return a.compare(b) == 0;
-}
-
-bool operator!=(big_integer const &a, big_integer const &b) {
-  return a.compare(b) != 0;
-}
-
-bool operator<(big_integer const &a, big_integer const &b) {
-  return a.compare(b) < 0;
-}
-
-bool operator>(big_integer const &a, big_integer const &b) {
-  return a.compare(b) > 0;
-}
+template<typename Storage>
+int32_t basic_big_integer<Storage>::compare_abs(basic_big_integer const& b) const {
+  if (size() != b.size()) {
+    return size() > b.size() ? 1 : -1;
+  }
 
-bool operator<=(big_integer const &a, big_integer const &b) {
-  return a.compare(b) <= 0;
+  const_limb_span x = value.span(), y = b.value.span();
+  for (size_t i = x.size; i > 0; i--) {
+    if (x.data[i - 1] != y.data[i - 1]) {
+      return x.data[i - 1] > y.data[i - 1] ? 1 : -1;
+    }
+  }
+  return 0;
 }
 
-bool operator>=(big_integer const &a, big_integer const &b) {
-  return a.compare(b) >= 0;
+template<typename Storage>
+std::string basic_big_integer<Storage>::to_decimal(basic_big_integer const& a) {
+  std::string digits = a.value.decimal([&a] { return magnitude_digits(a); });
+  return a.sign ? '-' + digits : digits;
 }
 
-std::string to_string(big_integer const& a) {
-  if (a.size() == 1 && a[0] == 0) {
+template<typename Storage>
+std::string basic_big_integer<Storage>::magnitude_digits(basic_big_integer const& a) {
+  if (a.is_zero()) {
     return "0";
   }
-  std::string s;
-  big_integer tmp(a);
+  std::string res;
+  basic_big_integer magnitude(a);
+  magnitude.sign = false;
+  write_digits(magnitude, 0, res);
+  return res;
+}
 
-  while (tmp != 0) {
-    s.push_back(static_cast<char> ((tmp % 10)[0] + static_cast<uint32_t>('0')));
-    tmp /= 10;
+// the quotient and the remainder by 10^(2^k) with about half the limbs of a are written separately,
+// the remainder padded to exactly 2^k digits
+template<typename Storage>
+void basic_big_integer<Storage>::write_digits(basic_big_integer const& a, size_t width, std::string& out) {
+  typedef constant_pool<basic_big_integer> pool;
+  if (a.size() <= DIGITS_BASECASE_LIMBS) {
+    // least significant digit first
+    std::string digits;
+    basic_big_integer tmp(a);
+    while (!tmp.is_zero()) {
+      uint32_t chunk = tmp.short_div(DECIMAL_CHUNK);
+      tmp.normalize();
+      for (size_t i = 0; i != 9; ++i) {
+        digits.push_back(static_cast<char>('0' + chunk % 10));
+        chunk /= 10;
+      }
+    }
+    while (!digits.empty() && digits.back() == '0') {
+      digits.pop_back();
+    }
+    if (digits.size() < width) {
+      digits.resize(width, '0');
+    }
+    out.append(digits.rbegin(), digits.rend());
+    return;
   }
 
-  if (a.sign) {
-    s.push_back('-');
+  size_t k = 0;
+  while (k + 1 < pool::POWERS && 2 * pool::power_of_ten(k + 1).size() <= a.size()) {
+    k++;
+  }
+  size_t low = static_cast<size_t>(1) << k;
+  basic_big_integer q, r;
+  divmod(q, r, a, pool::power_of_ten(k));
+  write_digits(q, width > low ? width - low : 0, out);
+  write_digits(r, low, out);
+}
+
+// the top digits times 10^(2^k) plus the lowest 2^k digits, for the largest 2^k shorter than the text
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::parse_digits(char const* first, char const* last) {
+  typedef constant_pool<basic_big_integer> pool;
+  size_t n = static_cast<size_t>(last - first);
+  if (n <= PARSE_BASECASE_DIGITS) {
+    basic_big_integer res;
+    while (first != last) {
+      size_t len = std::min<size_t>(9, static_cast<size_t>(last - first));
+      uint32_t chunk = 0, scale = 1;
+      for (size_t i = 0; i != len; ++i) {
+        chunk = chunk * 10 + static_cast<uint32_t>(*first++ - '0');
+        scale *= 10;
+      }
+      res.mul_short(scale);
+      res.add_abs(basic_big_integer(chunk));
+    }
+    return res;
   }
-  std::reverse(s.begin(), s.end());
-  return s;
-}
 
-std::ostream& operator<<(std::ostream& s, big_integer const& a) {
-  return s << to_string(a);
+  size_t k = 0;
+  while (k + 1 < pool::POWERS && (static_cast<size_t>(2) << k) < n) {
+    k++;
+  }
+  size_t low = static_cast<size_t>(1) << k;
+  basic_big_integer res = parse_digits(first, last - low) * pool::power_of_ten(k);
+  res.add_abs(parse_digits(last - low, last));
+  return res;
 }
 
-void big_integer::normalize() {
+template<typename Storage>
+void basic_big_integer<Storage>::normalize() {
   if (size() == 0) {
     push_back(0);
   }
@@ -477,30 +901,92 @@ void big_integer::normalize() {
   }
 }
 
-void big_integer::push_back(uint32_t x) {
+template<typename Storage>
+void basic_big_integer<Storage>::push_back(uint32_t x) {
   value.push_back(x);
 }
 
-uint32_t &big_integer::operator[](size_t i) {
+template<typename Storage>
+uint32_t &basic_big_integer<Storage>::operator[](size_t i) {
   return value[i];
 }
 
-uint32_t const& big_integer::operator[](size_t i) const {
+template<typename Storage>
+uint32_t const& basic_big_integer<Storage>::operator[](size_t i) const {
   return value[i];
 }
 
-void big_integer::pop_back() {
+template<typename Storage>
+void basic_big_integer<Storage>::pop_back() {
   value.pop_back();
 }
 
-void big_integer::reverse() {
-  value.reverse();
-}
-
-size_t big_integer::size() const{
+template<typename Storage>
+size_t basic_big_integer<Storage>::size() const{
   return value.get_size();
 }
 
-uint32_t const& big_integer::back() const{
+template<typename Storage>
+uint32_t const& basic_big_integer<Storage>::back() const{
   return value.back();
 }
+
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::from_uint64(uint64_t x) {
+  basic_big_integer res(static_cast<uint32_t>(x & UINT32_MAX));
+  if (x > UINT32_MAX) {
+    res.push_back(static_cast<uint32_t>(x >> 32));
+  }
+  return res;
+}
+
+template<typename Storage>
+bool basic_big_integer<Storage>::is_zero() const {
+  return size() == 1 && (*this)[0] == 0;
+}
+
+template<typename Storage>
+size_t basic_big_integer<Storage>::bit_length() const {
+  if (is_zero()) {
+    return 0;
+  }
+
+  size_t bits = 32 * (size() - 1);
+  for (uint32_t top = back(); top != 0; top >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+// top 64 bits of the magnitude, |*this| ~ result * 2^shift
+template<typename Storage>
+uint64_t basic_big_integer<Storage>::top_bits(size_t& shift) const {
+  size_t bits = bit_length();
+  if (bits <= 64) {
+    shift = 0;
+    return size() == 1 ? (*this)[0] : (static_cast<uint64_t>((*this)[1]) << 32) | (*this)[0];
+  }
+
+  shift = bits - 64;
+  size_t limb = shift / 32, bit = shift % 32;
+  uint64_t res = (static_cast<uint64_t>((*this)[limb + 1]) << 32) | (*this)[limb];
+  res >>= bit;
+  if (bit != 0) {
+    res |= static_cast<uint64_t>((*this)[limb + 2]) << (64 - bit);
+  }
+  return res;
+}
+
+template<typename Storage>
+uint32_t basic_big_integer<Storage>::short_mod(uint32_t b) const {
+  const_limb_span x = value.span();
+  uint64_t carry = 0;
+  for (size_t i = x.size; i != 0; i--) {
+    carry = ((carry << 32) | x.data[i - 1]) % b;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+template struct basic_big_integer<buffer>;
+template struct basic_big_integer<vector_storage>;
+template struct basic_big_integer<pooled_storage>;
@@ -5,93 +5,42 @@
 #ifndef HW02_BIG_INTEGER__BIG_INTEGER_H_
 #define HW02_BIG_INTEGER__BIG_INTEGER_H_
 
-#include <string>
-#include <utility>
-#include <functional>
-#include "buffer.h"
+#include "basic_big_integer.h"
 
-struct big_integer {
-  big_integer();
-  big_integer(big_integer const& value);
-  big_integer(int value);
-  explicit big_integer(std::string const& str);
-  ~big_integer();
+// small numbers inline, larger ones in copy-on-write limbs
+typedef basic_big_integer<buffer> big_integer;
 
-  big_integer& operator=(big_integer const& a);
+inline big_integer isqrt(big_integer const& a) {
+  return big_integer::isqrt(a);
+}
 
-  big_integer& operator+=(big_integer const& a);
-  big_integer& operator-=(big_integer const& a);
-  big_integer& operator*=(big_integer const& a);
-  big_integer& operator/=(big_integer const& a);
-  big_integer& operator%=(big_integer const& a);
-  big_integer& operator&=(big_integer const& a);
-  big_integer& operator|=(big_integer const& a);
-  big_integer& operator^=(big_integer const& a);
+inline big_integer iroot(big_integer const& a, uint32_t k) {
+  return big_integer::iroot(a, k);
+}
 
-  big_integer& operator<<=(int value);
-  big_integer& operator>>=(int value);
+inline bool is_square(big_integer const& a) {
+  return big_integer::is_square(a);
+}
 
-  big_integer operator+() const;
-  big_integer operator-() const;
-  big_integer operator~() const;
+inline big_integer gcd(big_integer const& a, big_integer const& b) {
+  return big_integer::gcd(a, b);
+}
 
-  big_integer& operator++();
-  big_integer operator++(int);
+inline big_integer pow(big_integer const& base, uint64_t exp) {
+  return big_integer::pow(base, exp);
+}
 
-  big_integer& operator--();
-  big_integer operator--(int);
+inline big_integer factorial(uint32_t n) {
+  return big_integer::factorial(n);
+}
 
-  friend big_integer operator+(big_integer a, big_integer const& b);
-  friend big_integer operator-(big_integer a, big_integer const& b);
-  friend big_integer operator/(big_integer a, big_integer const& b);
-  friend big_integer operator*(big_integer a, big_integer const& b);
-  friend big_integer operator%(big_integer a, big_integer const& b);
+inline big_integer binomial(uint32_t n, uint32_t k) {
+  return big_integer::binomial(n, k);
+}
 
-  friend big_integer operator&(big_integer a, big_integer const& b);
-  friend big_integer operator|(big_integer a, big_integer const& b);
-  friend big_integer operator^(big_integer a, big_integer const& b);
-
-  friend big_integer operator<<(big_integer a, int b);
-  friend big_integer operator>>(big_integer a, int b);
-
-  friend bool operator==(big_integer const& a, big_integer const& b);
-  friend bool operator!=(big_integer const& a, big_integer const& b);
-  friend bool operator<(big_integer const& a, big_integer const& b);
-  friend bool operator>(big_integer const& a, big_integer const& b);
-  friend bool operator<=(big_integer const& a, big_integer const& b);
-  friend bool operator>=(big_integer const& a, big_integer const& b);
-
-  friend std::string to_string(big_integer const& a);
-
-  bool sign;
- private:
-  buffer value;
-
-  big_integer(uint32_t value);
-  explicit big_integer(size_t n);
-
-  uint32_t& operator[](size_t i);
-  void push_back(uint32_t x);
-  void pop_back();
-  void normalize();
-  void reverse();
-
-  int32_t compare(big_integer const& b) const;
-  uint32_t const& operator[](size_t i) const;
-  size_t size() const;
-  uint32_t const& back() const;
-
-  std::pair<big_integer, big_integer> div_mod(big_integer const& b);
-  uint32_t short_div(uint32_t b);
-  uint32_t trial(big_integer const &b);
-  bool smaller(big_integer const &b, size_t m);
-  void difference(big_integer const &b, size_t m);
-
-  void additional_code();
-  big_integer binary_operation(big_integer const& b, const std::function<uint32_t(uint32_t, uint32_t)>& func);
-};
-
-std::string to_string(big_integer const& a);
-std::ostream& operator<<(std::ostream& s, big_integer const& a);
+// trial division, then Baillie-PSW plus rounds extra Miller-Rabin bases
+inline bool is_probable_prime(big_integer const& n, size_t rounds = 0) {
+  return big_integer::is_probable_prime(n, rounds);
+}
 
 #endif //HW02_BIG_INTEGER__BIG_INTEGER_H_
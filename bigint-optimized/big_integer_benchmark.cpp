@@ -0,0 +1,568 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "big_integer.h"
+#include "big_integer_gmp.h"
+#include "big_decimal_integer.h"
+#include "big_float.h"
+#include "big_rational.h"
+#include "binary_splitting.h"
+#include "compact_big_integer.h"
+#include "fixed_int.h"
+
+namespace {
+template<typename F>
+double measure(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<std::string> random_odd_numbers(size_t count, size_t bits, std::default_random_engine& rng) {
+  std::vector<std::string> res;
+  for (size_t i = 0; i != count; ++i) {
+    big_integer_gmp a;
+    a.random(bits, rng);
+    if (a < 0) {
+      a = -a;
+    }
+    res.push_back(to_string(a | 1));
+  }
+  return res;
+}
+
+void primality() {
+  std::printf("is_probable_prime vs mpz_probab_prime_p, 1000 random odd numbers\n");
+  std::printf("%8s %8s %12s %12s\n", "bits", "primes", "big_integer", "gmp");
+
+  std::default_random_engine rng(42);
+  for (size_t bits : {64, 256, 512, 1024, 2048}) {
+    std::vector<std::string> numbers = random_odd_numbers(1000, bits, rng);
+    std::vector<big_integer> ours(numbers.begin(), numbers.end());
+    std::vector<big_integer_gmp> gmp(numbers.begin(), numbers.end());
+
+    size_t ours_primes = 0, gmp_primes = 0;
+    double ours_ms = measure([&] {
+      for (big_integer const& x : ours) {
+        ours_primes += is_probable_prime(x);
+      }
+    });
+    double gmp_ms = measure([&] {
+      for (big_integer_gmp const& x : gmp) {
+        gmp_primes += is_probable_prime(x);
+      }
+    });
+
+    std::printf("%8zu %8zu %10.1fms %10.1fms%s\n", bits, ours_primes, ours_ms, gmp_ms,
+                ours_primes == gmp_primes ? "" : " (prime counts differ)");
+  }
+}
+
+// the operations of the correctness_random tests on 2048-bit operands
+template<typename Number>
+void random_workload(std::vector<Number> const& a, std::vector<Number> const& b) {
+  for (size_t i = 0; i != a.size(); ++i) {
+    Number r = a[i] + b[i];
+    r = a[i] - b[i];
+    r = a[i] * b[i];
+    r = a[i] / (b[i] >> 1024);
+    r = a[i] % (b[i] >> 1024);
+    r = a[i] & b[i];
+    r = a[i] | b[i];
+    r = a[i] ^ b[i];
+    r = a[i] << 100;
+    r = a[i] >> 100;
+  }
+}
+
+void allocations() {
+  std::printf("\nlimb storage allocations, random test workload on 2048-bit numbers\n");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = random_odd_numbers(2000, 2048, rng);
+  std::vector<big_integer> a(numbers.begin(), numbers.begin() + 1000), b(numbers.begin() + 1000, numbers.end());
+
+  for (size_t round = 0; round != 2; ++round) {
+    limb_pool::statistics before = limb_pool::thread_statistics();
+    double ms = measure([&] {
+      random_workload(a, b);
+    });
+    limb_pool::statistics after = limb_pool::thread_statistics();
+    std::printf("round %zu: %zu requests, %zu reached the system allocator, %.1fms\n", round + 1,
+                after.requests - before.requests, after.system_allocations - before.system_allocations, ms);
+  }
+}
+
+// most values are 64-256 bits: 50% up to 64, 35% up to 256, 15% up to 1024
+std::vector<std::string> typical_numbers(size_t count, std::default_random_engine& rng) {
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::vector<std::string> res;
+  for (size_t i = 0; i != count; ++i) {
+    int p = percent(rng);
+    size_t max_bits = p < 50 ? 64 : p < 85 ? 256 : 1024;
+    size_t bits = std::uniform_int_distribution<size_t>(max_bits / 4, max_bits)(rng);
+    big_integer_gmp a;
+    a.random(bits, rng);
+    res.push_back(to_string(a));
+  }
+  return res;
+}
+
+void inline_capacity() {
+  std::printf("\ninline capacity %zu limbs, sizeof(big_integer) = %zu, 100000 values of typical size\n",
+              buffer::MAX_SMALL, sizeof(big_integer));
+  std::printf("%8s %10s %10s %10s %10s %10s\n", "", "copy", "add", "mul", "sort", "requests");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = typical_numbers(100000, rng);
+  std::vector<big_integer> a(numbers.begin(), numbers.end());
+
+  for (size_t round = 0; round != 2; ++round) {
+    limb_pool::statistics before = limb_pool::thread_statistics();
+    std::vector<big_integer> b;
+    double copy_ms = measure([&] {
+      b = a;
+    });
+    double add_ms = measure([&] {
+      for (size_t i = 0; i + 1 < b.size(); ++i) {
+        b[i] += a[i + 1];
+      }
+    });
+    double mul_ms = measure([&] {
+      for (size_t i = 0; i + 1 < b.size(); ++i) {
+        b[i] = a[i] * a[i + 1];
+      }
+    });
+    double sort_ms = measure([&] {
+      std::sort(b.begin(), b.end());
+    });
+    limb_pool::statistics after = limb_pool::thread_statistics();
+    std::printf("round %zu %8.1fms %8.1fms %8.1fms %8.1fms %10zu\n", round + 1, copy_ms, add_ms, mul_ms, sort_ms,
+                after.requests - before.requests);
+  }
+}
+
+template<typename Number>
+void storage_row(char const* name, std::vector<std::string> const& typical, std::vector<std::string> const& large) {
+  std::vector<Number> small(typical.begin(), typical.end());
+  auto mid = large.begin() + large.size() / 2;
+  std::vector<Number> a(large.begin(), mid), b(mid, large.end());
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  double copy_ms = measure([&] {
+    std::vector<Number> copies(small);
+    std::sort(copies.begin(), copies.end());
+  });
+  double workload_ms = measure([&] {
+    random_workload(a, b);
+  });
+  limb_pool::statistics after = limb_pool::thread_statistics();
+  std::printf("%-16s %8zu %10.1fms %10.1fms %10zu\n", name, sizeof(Number), copy_ms, workload_ms,
+              after.requests - before.requests);
+}
+
+// the same engine over every storage
+void storages() {
+  std::printf("\nstorages: copy and sort 100000 typical values, random test workload on 2048-bit numbers\n");
+  std::printf("%-16s %8s %12s %12s %10s\n", "", "sizeof", "copy+sort", "workload", "requests");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> typical = typical_numbers(100000, rng);
+  std::vector<std::string> large = random_odd_numbers(2000, 2048, rng);
+  storage_row<big_integer>("buffer", typical, large);
+  storage_row<basic_big_integer<vector_storage>>("vector", typical, large);
+  storage_row<basic_big_integer<pooled_storage>>("pooled vector", typical, large);
+}
+
+// counters and identifiers: 90% fit in 62 bits, the rest take up to 256
+std::vector<std::string> mostly_small_numbers(size_t count, std::default_random_engine& rng) {
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::vector<std::string> res;
+  for (size_t i = 0; i != count; ++i) {
+    size_t bits = std::uniform_int_distribution<size_t>(8, percent(rng) < 90 ? 60 : 256)(rng);
+    big_integer_gmp a;
+    a.random(bits, rng);
+    res.push_back(to_string(a));
+  }
+  return res;
+}
+
+size_t heap_bytes(big_integer const& a) {
+  return a.capacity() > buffer::MAX_SMALL
+         ? limb_pool::good_size(sizeof(shared_container) + a.capacity() * sizeof(uint32_t)) : 0;
+}
+
+size_t heap_bytes(compact_big_integer const& a) {
+  return a.heap_bytes();
+}
+
+template<typename Number>
+void compact_row(char const* name, std::vector<std::string> const& numbers) {
+  std::vector<Number> a;
+  for (std::string const& s : numbers) {
+    a.emplace_back(big_integer(s));
+  }
+  size_t bytes = a.size() * sizeof(Number);
+  for (Number const& x : a) {
+    bytes += heap_bytes(x);
+  }
+
+  std::vector<Number> b;
+  Number sum;
+  double copy_ms = measure([&] {
+    b = a;
+  });
+  double sum_ms = measure([&] {
+    for (Number const& x : a) {
+      sum += x;
+    }
+  });
+  double mul_ms = measure([&] {
+    for (size_t i = 0; i + 1 < b.size(); ++i) {
+      b[i] = a[i] * a[i + 1];
+    }
+  });
+  double sort_ms = measure([&] {
+    std::sort(b.begin(), b.end());
+  });
+  std::printf("%-12s %8.1f %8.1fms %8.1fms %8.1fms %8.1fms\n", name, double(bytes) / a.size(), copy_ms, sum_ms,
+              mul_ms, sort_ms);
+}
+
+void compact() {
+  std::printf("\ncompact handles, 1000000 values, 90%% of them below 2^62\n");
+  std::printf("%-12s %8s %10s %10s %10s %10s\n", "", "bytes", "copy", "sum", "mul", "sort");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = mostly_small_numbers(1000000, rng);
+  compact_row<big_integer>("big_integer", numbers);
+  compact_row<compact_big_integer>("compact", numbers);
+}
+
+template<typename Number>
+void decimal_row(char const* name, std::vector<std::string> const& numbers) {
+  std::vector<Number> a;
+  double parse_ms = measure([&] {
+    for (std::string const& s : numbers) {
+      a.emplace_back(s);
+    }
+  });
+  Number sum = 0;
+  double sum_ms = measure([&] {
+    for (Number const& x : a) {
+      sum += x;
+    }
+  });
+  size_t length = 0;
+  double print_ms = measure([&] {
+    for (Number const& x : a) {
+      length += to_string(x).size();
+    }
+  });
+  double mul_ms = measure([&] {
+    for (size_t i = 0; i + 1 < a.size(); ++i) {
+      length += (a[i] * a[i + 1] < sum);
+    }
+  });
+  double div_ms = measure([&] {
+    for (size_t i = 0; i + 1 < a.size(); ++i) {
+      length += (a[i] * a[i + 1] / (a[i] + 1) < sum);
+    }
+  });
+  std::printf("%-20s %8.1fms %8.1fms %8.1fms %8.1fms %8.1fms%s\n", name, parse_ms, sum_ms, print_ms, mul_ms, div_ms,
+              to_string(sum).size() != 0 && length != 0 ? "" : " (empty)");
+}
+
+// reading, adding and printing decimal text against multiplication and division
+void decimal() {
+  std::printf("\nbinary vs decimal limbs, 1000 numbers\n");
+  std::printf("%-20s %10s %10s %10s %10s %10s\n", "", "parse", "sum", "print", "mul", "mul+div");
+
+  std::default_random_engine rng(42);
+  for (size_t bits : {256, 4096}) {
+    std::vector<std::string> numbers = random_odd_numbers(1000, bits, rng);
+    std::printf("%zu bits\n", bits);
+    decimal_row<big_integer>("big_integer", numbers);
+    decimal_row<big_decimal_integer>("big_decimal_integer", numbers);
+  }
+}
+
+// multiply-accumulate and compare, the shape of hash mixing and counters
+void fixed() {
+  std::printf("\nfixed_int<256> vs big_integer, 100 passes of acc = acc * a[i] + a[i + 1] over 10000 values\n");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = random_odd_numbers(10000, 250, rng);
+  std::vector<int256> fixed(numbers.size());
+  std::vector<big_integer> big(numbers.size());
+  for (size_t i = 0; i != numbers.size(); ++i) {
+    fixed[i] = int256(numbers[i]);
+    big[i] = big_integer(numbers[i]);
+  }
+
+  int256 fixed_acc = 1;
+  big_integer big_acc = 1;
+  size_t fixed_less = 0, big_less = 0;
+  double fixed_ms = measure([&] {
+    for (size_t round = 0; round != 100; ++round) {
+      for (size_t i = 0; i + 1 < fixed.size(); ++i) {
+        fixed_acc = fixed_acc * fixed[i] + fixed[i + 1];
+        fixed_less += fixed[i] < fixed[i + 1];
+      }
+    }
+  });
+  // wraps like fixed_int, so both keep 256-bit operands
+  double big_ms = measure([&] {
+    big_integer mask = (big_integer(1) << 256) - 1;
+    for (size_t round = 0; round != 100; ++round) {
+      for (size_t i = 0; i + 1 < big.size(); ++i) {
+        big_acc = (big_acc * big[i] + big[i + 1]) & mask;
+        big_less += big[i] < big[i + 1];
+      }
+    }
+  });
+  std::printf("fixed_int %.1fms, big_integer %.1fms%s\n", fixed_ms, big_ms,
+              fixed_less == big_less && int256(big_acc) == fixed_acc ? "" : " (results differ)");
+}
+}
+
+// every thread copies shared 2048-bit constants and compares the copies, the limbs are never duplicated
+void shared_reads() {
+  std::printf("\nshared constants, 1000 numbers of 2048 bits, 1000 copy/compare passes per thread (%s refcount)\n",
+              BIGINT_ATOMIC_REFCOUNT ? "atomic" : "plain");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = random_odd_numbers(1000, 2048, rng);
+  std::vector<big_integer> const constants(numbers.begin(), numbers.end());
+
+  for (size_t threads : {1, 2, 4, 8}) {
+    if (!BIGINT_ATOMIC_REFCOUNT && threads > 1) {
+      break;
+    }
+    std::vector<size_t> less(threads);
+    double ms = measure([&] {
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([&constants, &less, t] {
+          for (size_t pass = 0; pass != 1000; ++pass) {
+            std::vector<big_integer> copies(constants);
+            for (size_t i = 0; i + 1 < copies.size(); ++i) {
+              less[t] += copies[i] < copies[i + 1];
+            }
+          }
+        });
+      }
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+    });
+    std::printf("%zu threads: %.1fms\n", threads, ms);
+  }
+}
+
+// the same shared values printed over and over, like in logs
+void printing() {
+  std::printf("\nto_string of 100 shared 4096-bit values, 10 times each\n");
+
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = random_odd_numbers(100, 4096, rng);
+  std::vector<big_integer> values(numbers.begin(), numbers.end());
+
+  for (size_t round = 0; round != 10; ++round) {
+    size_t length = 0;
+    double ms = measure([&] {
+      for (big_integer const& x : values) {
+        big_integer copy = x;
+        length += to_string(copy).size();
+      }
+    });
+    std::printf("round %zu: %.2fms%s\n", round + 1, ms, length != 0 ? "" : " (empty)");
+  }
+}
+
+// gcd of 4096-bit numbers, then rational sums and continued fractions reduced after every step or only when needed
+void rational() {
+  std::printf("\ngcd of 1000 pairs of 4096-bit numbers\n");
+  std::default_random_engine rng(42);
+  std::vector<std::string> numbers = random_odd_numbers(2000, 4096, rng);
+  std::vector<big_integer> a(numbers.begin(), numbers.end());
+  big_integer lehmer_sum = 0, euclid_sum = 0;
+  double lehmer_ms = measure([&] {
+    for (size_t i = 0; i + 1 < a.size(); i += 2) {
+      lehmer_sum += gcd(a[i], a[i + 1]);
+    }
+  });
+  double euclid_ms = measure([&] {
+    for (size_t i = 0; i + 1 < a.size(); i += 2) {
+      big_integer x = a[i], y = a[i + 1];
+      while (y != 0) {
+        big_integer t = x % y;
+        x = y;
+        y = t;
+      }
+      euclid_sum += x;
+    }
+  });
+  std::printf("lehmer %.1fms, euclid %.1fms%s\n", lehmer_ms, euclid_ms,
+              lehmer_sum == euclid_sum ? "" : " (results differ)");
+
+  std::printf("%-28s %10s %10s\n", "", "eager", "lazy");
+  for (bool lazy : {false, true}) {
+    big_rational h = 0;
+    double ms = measure([&] {
+      for (int i = 1; i <= 5000; ++i) {
+        h += big_rational(1, i);
+        if (!lazy) {
+          h.reduce();
+        }
+      }
+      h.reduce();
+    });
+    if (!lazy) {
+      std::printf("%-28s", "harmonic sum, 5000 terms");
+    }
+    std::printf(" %8.1fms%s", ms, lazy ? "\n" : "");
+  }
+
+  // e = [2; 1, 2, 1, 1, 4, 1, 1, 6, ...], evaluated from the last term
+  for (bool lazy : {false, true}) {
+    big_rational x = 1;
+    double ms = measure([&] {
+      for (int i = 6000; i != 0; --i) {
+        int term = i % 3 == 2 ? 2 * (i / 3 + 1) : 1;
+        x = big_rational(term) + big_rational(1) / x;
+        if (!lazy) {
+          x.reduce();
+        }
+      }
+      x += 1;
+      x.reduce();
+    });
+    if (!lazy) {
+      std::printf("%-28s", "e continued fraction, 6000");
+    }
+    std::printf(" %8.1fms%s", ms, lazy ? "\n" : "");
+  }
+}
+
+// correctly rounded quotients and square roots against the exact integer ones they are rounded from
+void floats() {
+  std::printf("\nbig_float division and sqrt vs exact big_integer division and isqrt, 10 operations\n");
+  std::printf("%-12s %10s %10s %10s %10s\n", "", "div", "int div", "sqrt", "isqrt");
+
+  std::default_random_engine rng(42);
+  for (size_t bits : {1000, 10000, 100000}) {
+    std::vector<std::string> numbers = random_odd_numbers(20, bits, rng);
+    std::vector<big_float> a;
+    std::vector<big_integer> b;
+    for (std::string const& s : numbers) {
+      a.emplace_back(big_integer(s), bits);
+      b.emplace_back(s);
+    }
+    size_t nonzero = 0;
+    double div_ms = measure([&] {
+      for (size_t i = 0; i + 1 < a.size(); i += 2) {
+        nonzero += (a[i] / a[i + 1]).mantissa() != 0;
+      }
+    });
+    double int_div_ms = measure([&] {
+      for (size_t i = 0; i + 1 < b.size(); i += 2) {
+        nonzero += ((b[i] << static_cast<int>(bits)) / b[i + 1]) != 0;
+      }
+    });
+    double sqrt_ms = measure([&] {
+      for (size_t i = 0; i < a.size(); i += 2) {
+        nonzero += sqrt(a[i]).mantissa() != 0;
+      }
+    });
+    double isqrt_ms = measure([&] {
+      for (size_t i = 0; i < b.size(); i += 2) {
+        nonzero += isqrt(b[i] << static_cast<int>(bits)) != 0;
+      }
+    });
+    std::printf("%-7zu bits %8.1fms %8.1fms %8.1fms %8.1fms%s\n", bits, div_ms, int_div_ms, sqrt_ms, isqrt_ms,
+                nonzero == 40 ? "" : " (zero results)");
+  }
+}
+
+// pi, e and ln 2 digits by binary splitting, the end-to-end test of multiplication, division, sqrt and printing
+void series() {
+  std::printf("\ndigits by binary splitting\n");
+  std::printf("%-16s %12s %12s\n", "", "big_integer", "gmp");
+
+  auto row = [](char const* name, size_t digits, std::string (* ours)(size_t), std::string (* gmp)(size_t)) {
+    std::string a, b;
+    double ours_ms = measure([&] {
+      a = ours(digits);
+    });
+    double gmp_ms = measure([&] {
+      b = gmp(digits);
+    });
+    std::printf("%-4s %7zu digits %10.1fms %10.1fms%s\n", name, digits, ours_ms, gmp_ms,
+                a == b ? "" : " (digits differ)");
+  };
+  for (size_t digits : {10000, 100000}) {
+    row("pi", digits, pi_digits<big_integer>, pi_digits<big_integer_gmp>);
+    row("e", digits, e_digits<big_integer>, e_digits<big_integer_gmp>);
+    row("ln2", digits, ln2_digits<big_integer>, ln2_digits<big_integer_gmp>);
+  }
+}
+
+// sections can be picked by name: primality, allocations, inline, threads, storages, compact, fixed, decimal, printing,
+// rational, float, series
+int main(int argc, char** argv) {
+  auto selected = [argc, argv](char const* name) {
+    if (argc == 1) {
+      return true;
+    }
+    for (int i = 1; i != argc; ++i) {
+      if (std::strcmp(argv[i], name) == 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (selected("primality")) {
+    primality();
+  }
+  if (selected("allocations")) {
+    allocations();
+  }
+  if (selected("inline")) {
+    inline_capacity();
+  }
+  if (selected("threads")) {
+    shared_reads();
+  }
+  if (selected("storages")) {
+    storages();
+  }
+  if (selected("compact")) {
+    compact();
+  }
+  if (selected("fixed")) {
+    fixed();
+  }
+  if (selected("decimal")) {
+    decimal();
+  }
+  if (selected("printing")) {
+    printing();
+  }
+  if (selected("rational")) {
+    rational();
+  }
+  if (selected("float")) {
+    floats();
+  }
+  if (selected("series")) {
+    series();
+  }
+}
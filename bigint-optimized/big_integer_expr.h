@@ -0,0 +1,222 @@
+#ifndef BIGINT__BIG_INTEGER_EXPR_H_
+#define BIGINT__BIG_INTEGER_EXPR_H_
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "big_integer.h"
+
+// Lazy arithmetic chains: r = lazy(a) * b + c * d - e is evaluated directly into r,
+// its storage is reserved once and products that can't be built in place go to per-thread scratch numbers.
+
+struct expr_ops {
+  static size_t size(big_integer const& a) {
+    return a.size();
+  }
+
+  static void reserve(big_integer& a, size_t n) {
+    a.reserve(n);
+  }
+
+  static void copy(big_integer& res, big_integer const& a) {
+    res.copy_from(a);
+  }
+};
+
+// numbers are taken from and returned to a per-thread free list, so their capacity survives between evaluations;
+// the list is only touched by scratches that are used, operands are multiplied where they are
+struct expr_scratch {
+  expr_scratch() : taken(false) {}
+
+  expr_scratch(expr_scratch const&) = delete;
+  expr_scratch& operator=(expr_scratch const&) = delete;
+
+  ~expr_scratch() {
+    if (taken) {
+      free_list().push_back(std::move(value));
+    }
+  }
+
+  big_integer& get() {
+    if (!taken) {
+      std::vector<big_integer>& pool = free_list();
+      if (!pool.empty()) {
+        value = std::move(pool.back());
+        pool.pop_back();
+      }
+      taken = true;
+    }
+    return value;
+  }
+
+ private:
+  big_integer value;
+  bool taken;
+
+  static std::vector<big_integer>& free_list() {
+    thread_local std::vector<big_integer> pool;
+    return pool;
+  }
+};
+
+template<typename Derived>
+struct expression {
+  typedef void expression_tag;
+
+  operator big_integer() const {
+    big_integer res;
+    res = static_cast<Derived const&>(*this);
+    return res;
+  }
+};
+
+struct operand_expr : expression<operand_expr> {
+  explicit operand_expr(big_integer const& x) : x(x) {}
+
+  size_t limbs() const {
+    return expr_ops::size(x);
+  }
+
+  bool aliases(big_integer const* p) const {
+    return &x == p;
+  }
+
+  void eval(big_integer& res) const {
+    expr_ops::copy(res, x);
+  }
+
+  void accumulate(big_integer& res, bool negate) const {
+    if (negate) {
+      res -= x;
+    } else {
+      res += x;
+    }
+  }
+
+  big_integer const& x;
+};
+
+inline big_integer const& materialize(operand_expr const& e, expr_scratch&) {
+  return e.x;
+}
+
+template<typename E>
+big_integer const& materialize(E const& e, expr_scratch& scratch) {
+  big_integer& value = scratch.get();
+  e.eval(value);
+  return value;
+}
+
+template<typename L, typename R>
+struct product_expr : expression<product_expr<L, R>> {
+  product_expr(L const& l, R const& r) : l(l), r(r) {}
+
+  size_t limbs() const {
+    return l.limbs() + r.limbs();
+  }
+
+  bool aliases(big_integer const* p) const {
+    return l.aliases(p) || r.aliases(p);
+  }
+
+  void eval(big_integer& res) const {
+    expr_scratch a, b;
+    mul(res, materialize(l, a), materialize(r, b));
+  }
+
+  void accumulate(big_integer& res, bool negate) const {
+    expr_scratch a, b;
+    if (negate) {
+      submul(res, materialize(l, a), materialize(r, b));
+    } else {
+      addmul(res, materialize(l, a), materialize(r, b));
+    }
+  }
+
+  L l;
+  R r;
+};
+
+template<typename L, typename R, bool Negate>
+struct sum_expr : expression<sum_expr<L, R, Negate>> {
+  sum_expr(L const& l, R const& r) : l(l), r(r) {}
+
+  size_t limbs() const {
+    return std::max(l.limbs(), r.limbs()) + 1;
+  }
+
+  bool aliases(big_integer const* p) const {
+    return l.aliases(p) || r.aliases(p);
+  }
+
+  void eval(big_integer& res) const {
+    l.eval(res);
+    r.accumulate(res, Negate);
+  }
+
+  void accumulate(big_integer& res, bool negate) const {
+    l.accumulate(res, negate);
+    r.accumulate(res, negate != Negate);
+  }
+
+  L l;
+  R r;
+};
+
+inline operand_expr lazy(big_integer const& x) {
+  return operand_expr(x);
+}
+
+template<typename T, typename = void>
+struct is_expression : std::false_type {};
+
+template<typename T>
+struct is_expression<T, typename T::expression_tag> : std::true_type {};
+
+template<typename T>
+struct expr_type {
+  typedef T type;
+};
+
+template<>
+struct expr_type<big_integer> {
+  typedef operand_expr type;
+};
+
+template<typename L, typename R>
+struct enable_expr : std::enable_if<(is_expression<L>::value || is_expression<R>::value) &&
+                                    (is_expression<L>::value || std::is_same<L, big_integer>::value) &&
+                                    (is_expression<R>::value || std::is_same<R, big_integer>::value)> {};
+
+template<typename L, typename R, typename = typename enable_expr<L, R>::type>
+product_expr<typename expr_type<L>::type, typename expr_type<R>::type> operator*(L const& l, R const& r) {
+  return {typename expr_type<L>::type(l), typename expr_type<R>::type(r)};
+}
+
+template<typename L, typename R, typename = typename enable_expr<L, R>::type>
+sum_expr<typename expr_type<L>::type, typename expr_type<R>::type, false> operator+(L const& l, R const& r) {
+  return {typename expr_type<L>::type(l), typename expr_type<R>::type(r)};
+}
+
+template<typename L, typename R, typename = typename enable_expr<L, R>::type>
+sum_expr<typename expr_type<L>::type, typename expr_type<R>::type, true> operator-(L const& l, R const& r) {
+  return {typename expr_type<L>::type(l), typename expr_type<R>::type(r)};
+}
+
+// expressions are built over big_integer, so only its storage can evaluate them
+template<typename Storage>
+template<typename E, typename>
+basic_big_integer<Storage>& basic_big_integer<Storage>::operator=(E const& e) {
+  if (e.aliases(this)) {
+    basic_big_integer tmp;
+    tmp = e;
+    return *this = std::move(tmp);
+  }
+
+  expr_ops::reserve(*this, e.limbs());
+  e.eval(*this);
+  return *this;
+}
+
+#endif //BIGINT__BIG_INTEGER_EXPR_H_
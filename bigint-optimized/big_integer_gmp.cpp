@@ -195,6 +195,22 @@ std::string to_string(big_integer_gmp const& a) {
   return res;
 }
 
+bool is_probable_prime(big_integer_gmp const& a, size_t rounds) {
+  return mpz_sgn(a.mpz) > 0 && mpz_probab_prime_p(a.mpz, static_cast<int>(rounds)) != 0;
+}
+
+big_integer_gmp isqrt(big_integer_gmp const& a) {
+  big_integer_gmp res;
+  mpz_sqrt(res.mpz, a.mpz);
+  return res;
+}
+
+big_integer_gmp pow(big_integer_gmp const& base, uint64_t exp) {
+  big_integer_gmp res;
+  mpz_pow_ui(res.mpz, base.mpz, static_cast<unsigned long>(exp));
+  return res;
+}
+
 std::ostream& operator<<(std::ostream& s, big_integer_gmp const& a) {
   return s << to_string(a);
 }
\ No newline at end of file
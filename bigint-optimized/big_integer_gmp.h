@@ -2,6 +2,7 @@
 #define BIG_INTEGER_GMP_H
 
 #include <cstddef>
+#include <cstdint>
 #include <gmp.h>
 #include <iosfwd>
 
@@ -59,6 +60,10 @@ struct big_integer_gmp {
   friend bool operator>=(big_integer_gmp const& a, big_integer_gmp const& b);
 
   friend std::string to_string(big_integer_gmp const& a);
+  friend bool is_probable_prime(big_integer_gmp const& a, size_t rounds);
+  // found by argument-dependent lookup only, isqrt(int) stays the big_integer one
+  friend big_integer_gmp isqrt(big_integer_gmp const& a);
+  friend big_integer_gmp pow(big_integer_gmp const& base, uint64_t exp);
 
  private:
   mpz_t mpz;
@@ -85,6 +90,7 @@ bool operator<=(big_integer_gmp const& a, big_integer_gmp const& b);
 bool operator>=(big_integer_gmp const& a, big_integer_gmp const& b);
 
 std::string to_string(big_integer_gmp const& a);
+bool is_probable_prime(big_integer_gmp const& a, size_t rounds = 25);
 std::ostream& operator<<(std::ostream& s, big_integer_gmp const& a);
 
 #endif // BIG_INTEGER_GMP_H
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef BIGINT__BIG_INTEGER_LITERAL_H_
+#define BIGINT__BIG_INTEGER_LITERAL_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include "big_integer.h"
+
+// 123456789012345678901234567890_bi, also with 0x, 0b and octal prefixes and ' separators.
+// The digits are parsed while compiling. The first evaluation of a literal puts the limbs into a number kept by
+// the literal itself; every evaluation returns a copy sharing them, so nothing is parsed or copied at run time
+// until the copy is changed. With a plain reference count such copies must not be made on different threads, so
+// there every evaluation builds its own number from the parsed limbs instead.
+
+template<size_t N>
+struct literal_limbs {
+  uint32_t data[N];
+  size_t size;
+};
+
+constexpr uint32_t literal_digit(char c) {
+  return c >= '0' && c <= '9' ? c - '0'
+         : c >= 'a' && c <= 'f' ? c - 'a' + 10
+         : c >= 'A' && c <= 'F' ? c - 'A' + 10
+         : UINT32_MAX;
+}
+
+// a digit takes at most 4 bits, so N = Length / 8 + 1 limbs always suffice
+template<size_t N, size_t Length>
+constexpr literal_limbs<N> parse_literal(char const (&s)[Length]) {
+  literal_limbs<N> res{{}, 1};
+  uint32_t base = 10;
+  size_t i = 0;
+  if (Length > 1 && s[0] == '0') {
+    if (s[1] == 'x' || s[1] == 'X') {
+      base = 16;
+      i = 2;
+    } else if (s[1] == 'b' || s[1] == 'B') {
+      base = 2;
+      i = 2;
+    } else {
+      base = 8;
+      i = 1;
+    }
+  }
+
+  for (; i != Length; ++i) {
+    if (s[i] == '\'') {
+      continue;
+    }
+    uint32_t digit = literal_digit(s[i]);
+    if (digit >= base) {
+      throw std::invalid_argument("not a digit of the literal's base");
+    }
+    uint64_t carry = digit;
+    for (size_t j = 0; j != res.size; ++j) {
+      uint64_t cur = uint64_t(res.data[j]) * base + carry;
+      res.data[j] = static_cast<uint32_t>(cur);
+      carry = cur >> 32;
+    }
+    if (carry != 0) {
+      res.data[res.size++] = static_cast<uint32_t>(carry);
+    }
+  }
+  return res;
+}
+
+struct literal_ops {
+  template<size_t N>
+  static big_integer make(literal_limbs<N> const& limbs) {
+    big_integer res(limbs.size);
+    limb_span x = res.value.span();
+    std::copy(limbs.data, limbs.data + limbs.size, x.data);
+    return res;
+  }
+};
+
+template<char... Digits>
+big_integer operator "" _bi() {
+  static constexpr char digits[] = {Digits...};
+  static constexpr literal_limbs<sizeof...(Digits) / 8 + 1> limbs = parse_literal<sizeof...(Digits) / 8 + 1>(digits);
+#if BIGINT_ATOMIC_REFCOUNT
+  static big_integer const value = literal_ops::make(limbs);
+  return value;
+#else
+  return literal_ops::make(limbs);
+#endif
+}
+
+#endif //BIGINT__BIG_INTEGER_LITERAL_H_
@@ -0,0 +1,693 @@
+#include "basic_big_integer.h"
+#include "constant_pool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+uint32_t const pow10_table[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+size_t window_size(size_t exp_bits) {
+  return exp_bits < 8 ? 1 : exp_bits < 24 ? 2 : exp_bits < 80 ? 3 : exp_bits < 240 ? 4 : 5;
+}
+
+// floor(((k - 1) * x + a / x^(k - 1)) / k), never below floor(a^(1/k))
+template<typename Number>
+Number root_step(Number const& a, Number const& x, uint32_t k) {
+  if (k == 2) {
+    return (x + a / x) >> 1;
+  }
+  return (x * static_cast<int>(k - 1) + a / Number::pow(x, k - 1)) / static_cast<int>(k);
+}
+
+// numbers lo, lo + step, ... below hi multiplied into 64-bit chunks
+std::vector<uint64_t> packed_range(uint64_t lo, uint64_t hi, uint64_t step) {
+  std::vector<uint64_t> res;
+  uint64_t acc = 1;
+  for (uint64_t m = lo; m < hi; m += step) {
+    if (acc > UINT64_MAX / m) {
+      res.push_back(acc);
+      acc = 1;
+    }
+    acc *= m;
+  }
+  res.push_back(acc);
+  return res;
+}
+
+// bits [shift, shift + 32) of the magnitude
+int64_t limb_at_bit(const_limb_span x, size_t shift) {
+  size_t limb = shift / 32, bit = shift % 32;
+  uint64_t res = limb < x.size ? x.data[limb] >> bit : 0;
+  if (bit != 0 && limb + 1 < x.size) {
+    res |= static_cast<uint64_t>(x.data[limb + 1]) << (32 - bit);
+  }
+  return static_cast<int64_t>(res & UINT32_MAX);
+}
+
+typedef std::vector<uint32_t> limbs;
+
+std::vector<uint32_t> const& small_primes() {
+  static std::vector<uint32_t> const primes = [] {
+    std::vector<uint32_t> res;
+    std::vector<bool> composite(2048);
+    for (uint32_t i = 2; i < composite.size(); i++) {
+      if (!composite[i]) {
+        res.push_back(i);
+        for (uint32_t j = i * i; j < composite.size(); j += i) {
+          composite[j] = true;
+        }
+      }
+    }
+    return res;
+  }();
+  return primes;
+}
+
+// odd primes grouped so that the product of every group fits into a limb
+std::vector<std::pair<uint32_t, size_t>> const& prime_groups() {
+  static std::vector<std::pair<uint32_t, size_t>> const groups = [] {
+    std::vector<std::pair<uint32_t, size_t>> res;
+    std::vector<uint32_t> const& primes = small_primes();
+    for (size_t i = 1; i < primes.size();) {
+      uint64_t prod = 1;
+      size_t j = i;
+      while (j < primes.size() && prod * primes[j] <= UINT32_MAX) {
+        prod *= primes[j++];
+      }
+      res.emplace_back(static_cast<uint32_t>(prod), j);
+      i = j;
+    }
+    return res;
+  }();
+  return groups;
+}
+
+// Jacobi symbol (a / n) for odd n
+int jacobi(uint32_t a, uint32_t n) {
+  int res = 1;
+  a %= n;
+  while (a != 0) {
+    while (a % 2 == 0) {
+      a /= 2;
+      if (n % 8 == 3 || n % 8 == 5) {
+        res = -res;
+      }
+    }
+    std::swap(a, n);
+    if (a % 4 == 3 && n % 4 == 3) {
+      res = -res;
+    }
+    a %= n;
+  }
+  return n == 1 ? res : 0;
+}
+
+// arithmetic modulo odd n on residues kept as x * 2^(32 * size) mod n
+struct montgomery {
+  explicit montgomery(limbs mod) : n(std::move(mod)), t(n.size() + 2) {
+    uint32_t inv = 1;
+    for (size_t i = 0; i < 5; i++) {
+      inv *= 2 - n[0] * inv;
+    }
+    n_inv = -inv;
+  }
+
+  void mul(limbs& res, limbs const& a, limbs const& b) {
+    size_t s = n.size();
+    std::fill(t.begin(), t.end(), 0);
+    for (size_t i = 0; i < s; i++) {
+      uint64_t carry = 0;
+      for (size_t j = 0; j < s; j++) {
+        uint64_t tmp = static_cast<uint64_t>(a[j]) * b[i] + t[j] + carry;
+        t[j] = static_cast<uint32_t>(tmp);
+        carry = tmp >> 32;
+      }
+      uint64_t tmp = static_cast<uint64_t>(t[s]) + carry;
+      t[s] = static_cast<uint32_t>(tmp);
+      t[s + 1] = static_cast<uint32_t>(tmp >> 32);
+
+      uint32_t m = t[0] * n_inv;
+      carry = (static_cast<uint64_t>(m) * n[0] + t[0]) >> 32;
+      for (size_t j = 1; j < s; j++) {
+        tmp = static_cast<uint64_t>(m) * n[j] + t[j] + carry;
+        t[j - 1] = static_cast<uint32_t>(tmp);
+        carry = tmp >> 32;
+      }
+      tmp = static_cast<uint64_t>(t[s]) + carry;
+      t[s - 1] = static_cast<uint32_t>(tmp);
+      t[s] = t[s + 1] + static_cast<uint32_t>(tmp >> 32);
+    }
+
+    res.assign(t.begin(), t.begin() + s);
+    if (t[s] != 0 || !less(res, n)) {
+      subtract(res, n);
+    }
+  }
+
+  void add(limbs& a, limbs const& b) const {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      uint64_t tmp = static_cast<uint64_t>(a[i]) + b[i] + carry;
+      a[i] = static_cast<uint32_t>(tmp);
+      carry = tmp >> 32;
+    }
+    if (carry != 0 || !less(a, n)) {
+      subtract(a, n);
+    }
+  }
+
+  void sub(limbs& a, limbs const& b) const {
+    if (less(a, b)) {
+      add_raw(a, n);
+    }
+    subtract(a, b);
+  }
+
+  void half(limbs& a) const {
+    uint32_t top = a[0] & 1 ? add_raw(a, n) : 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      uint32_t next = i + 1 < a.size() ? a[i + 1] : top;
+      a[i] = (a[i] >> 1) | (next << 31);
+    }
+  }
+
+  limbs n;
+
+ private:
+  static bool less(limbs const& a, limbs const& b) {
+    for (size_t i = a.size(); i != 0; i--) {
+      if (a[i - 1] != b[i - 1]) {
+        return a[i - 1] < b[i - 1];
+      }
+    }
+    return false;
+  }
+
+  static uint32_t add_raw(limbs& a, limbs const& b) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      uint64_t tmp = static_cast<uint64_t>(a[i]) + b[i] + carry;
+      a[i] = static_cast<uint32_t>(tmp);
+      carry = tmp >> 32;
+    }
+    return static_cast<uint32_t>(carry);
+  }
+
+  static void subtract(limbs& a, limbs const& b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      int64_t tmp = static_cast<int64_t>(a[i]) - b[i] - borrow;
+      a[i] = static_cast<uint32_t>(tmp);
+      borrow = tmp < 0;
+    }
+  }
+
+  uint32_t n_inv;
+  limbs t;
+};
+}
+
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::iroot(basic_big_integer const& a, uint32_t k) {
+  if (k == 0) {
+    throw std::domain_error("zero degree root");
+  }
+  if (a.sign) {
+    if (k % 2 == 0) {
+      throw std::domain_error("even degree root of negative number");
+    }
+    return -iroot(-a, k);
+  }
+  if (k == 1 || a.is_zero()) {
+    return a;
+  }
+
+  size_t bits = a.bit_length();
+  if (bits <= k) {
+    return 1;
+  }
+
+  basic_big_integer x;
+  size_t root_bits = (bits + k - 1) / k;
+  if (root_bits <= 32) {
+    // seed from the top limbs: a ~ top * 2^(q * k + r)
+    size_t shift;
+    uint64_t top = a.top_bits(shift);
+    size_t q = shift / k, r = shift % k;
+    double m = std::exp2((std::log2(static_cast<double>(top)) + static_cast<double>(r)) / k);
+    x = basic_big_integer::from_uint64(static_cast<uint64_t>(m) + 1) << static_cast<int>(q);
+  } else {
+    // root of the top half gives half of the digits, Newton doubles them
+    size_t h = root_bits / 2;
+    x = (iroot(a >> static_cast<int>(h * k), k) + 1) << static_cast<int>(h);
+  }
+
+  x = root_step(a, x, k);
+  while (true) {
+    basic_big_integer y = root_step(a, x, k);
+    if (y >= x) {
+      return x;
+    }
+    x = y;
+  }
+}
+
+template<typename Storage>
+bool basic_big_integer<Storage>::is_square(basic_big_integer const& a) {
+  if (a.sign) {
+    return false;
+  }
+  if (a.is_zero()) {
+    return true;
+  }
+
+  // squares mod 64 are 0, 1, 4, 9, 16, 17, 25, 33, 36, 41, 49, 57
+  static uint64_t const residues_64 = 0x0202021202030213ULL;
+  if (!((residues_64 >> (a[0] & 63)) & 1)) {
+    return false;
+  }
+
+  // the same for the squares mod 63, 65 and 11, 64 is a square mod 65 and takes a second word
+  static uint64_t const residues_63 = 0x0402483012450293ULL;
+  static uint64_t const residues_65[2] = {0x218a019866014613ULL, 1};
+  static uint32_t const residues_11 = 0x23b;
+  uint32_t r = a.short_mod(63 * 65 * 11), r_65 = r % 65;
+  if (!((residues_63 >> (r % 63)) & 1) || !((residues_65[r_65 / 64] >> (r_65 % 64)) & 1)
+      || !((residues_11 >> (r % 11)) & 1)) {
+    return false;
+  }
+
+  basic_big_integer root = isqrt(a);
+  return root * root == a;
+}
+
+// Lehmer: the quotients of Euclid's algorithm are taken from the leading 32 bits of both numbers as long as they
+// are certain, then applied at once as two products by a limb; a full division step only when none was certain
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::gcd(basic_big_integer const& a, basic_big_integer const& b) {
+  basic_big_integer x(a), y(b);
+  x.sign = y.sign = false;
+  if (x.compare_abs(y) < 0) {
+    std::swap(x, y);
+  }
+
+  // px + qy, the cofactors have opposite signs and are below 2^32 in absolute value, the result is non-negative
+  auto combine = [](basic_big_integer const& x, int64_t p, basic_big_integer const& y, int64_t q) {
+    basic_big_integer u(x), v(y);
+    u.mul_short(static_cast<uint32_t>(p < 0 ? -p : p));
+    v.mul_short(static_cast<uint32_t>(q < 0 ? -q : q));
+    return p > 0 || q < 0 ? u - v : v - u;
+  };
+
+  while (y.size() > 2) {
+    size_t shift = x.bit_length() - 32;
+    int64_t xh = limb_at_bit(x.value.cspan(), shift), yh = limb_at_bit(y.value.cspan(), shift);
+    int64_t p0 = 1, q0 = 0, p1 = 0, q1 = 1;
+    while (yh + p1 != 0 && yh + q1 != 0) {
+      int64_t quot = (xh + p0) / (yh + p1);
+      if (quot != (xh + q0) / (yh + q1)) {
+        break;
+      }
+      int64_t t = p0 - quot * p1;
+      p0 = p1;
+      p1 = t;
+      t = q0 - quot * q1;
+      q0 = q1;
+      q1 = t;
+      t = xh - quot * yh;
+      xh = yh;
+      yh = t;
+    }
+
+    if (q0 == 0) {
+      x %= y;
+      std::swap(x, y);
+    } else {
+      basic_big_integer t = combine(x, p0, y, q0);
+      y = combine(x, p1, y, q1);
+      x = std::move(t);
+    }
+  }
+
+  if (y.is_zero()) {
+    return x;
+  }
+  size_t shift;
+  uint64_t u = (x % y).top_bits(shift), v = y.top_bits(shift);
+  while (u != 0) {
+    uint64_t t = v % u;
+    v = u;
+    u = t;
+  }
+  return from_uint64(v);
+}
+
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::pow(basic_big_integer const& base, uint64_t exp) {
+  if (exp == 0) {
+    return 1;
+  }
+  if (exp == 1 || base.is_zero()) {
+    return base;
+  }
+  bool negative = base.sign && (exp & 1);
+
+  size_t bits = base.bit_length();
+  bool power_of_two = (base.back() & (base.back() - 1)) == 0;
+  for (size_t i = 0; power_of_two && i + 1 < base.size(); i++) {
+    power_of_two = base[i] == 0;
+  }
+  if (bits > 1 && exp > INT_MAX / (bits - 1)) {
+    throw std::length_error("power is too large");
+  }
+  if (power_of_two) {
+    basic_big_integer res = basic_big_integer(1) << static_cast<int>((bits - 1) * exp);
+    res.sign = negative;
+    return res;
+  }
+
+  if (base.size() == 1 && base[0] == 10) {
+    // 10^exp is the product of the cached 10^(2^k) for the bits of exp, or (10^9)^(exp / 9) * 10^(exp % 9)
+    typedef constant_pool<basic_big_integer> pool;
+    basic_big_integer res;
+    if (exp < 9) {
+      res = basic_big_integer(pow10_table[exp]);
+    } else if (pool::POWERS >= 64 || exp >> pool::POWERS == 0) {
+      res = basic_big_integer(1);
+      for (size_t k = 0; k != pool::POWERS && k != 64; ++k) {
+        if ((exp >> k) & 1) {
+          res *= pool::power_of_ten(k);
+        }
+      }
+    } else {
+      res = pow(basic_big_integer(pow10_table[9]), exp / 9) * basic_big_integer(pow10_table[exp % 9]);
+    }
+    res.sign = negative;
+    return res;
+  }
+
+  size_t exp_bits = 0;
+  for (uint64_t e = exp; e != 0; e >>= 1) {
+    exp_bits++;
+  }
+
+  // both accumulators hold the result from the start, every step writes into the other one
+  size_t limbs = bits * exp / 32 + 1;
+  basic_big_integer res, tmp;
+  res.reserve(limbs);
+  tmp.reserve(limbs);
+  if (base.size() == 1) {
+    // multiplication by a single limb is linear, only squarings matter
+    basic_big_integer b(base[0]);
+    res.copy_from(b);
+    for (size_t i = exp_bits - 1; i != 0; i--) {
+      square_to(tmp, res);
+      std::swap(res, tmp);
+      if ((exp >> (i - 1)) & 1) {
+        res.mul_short(base[0]);
+      }
+    }
+  } else {
+    // left-to-right sliding window over precomputed odd powers
+    size_t w = window_size(exp_bits);
+    basic_big_integer b = base;
+    b.sign = false;
+    std::vector<basic_big_integer> odd(static_cast<size_t>(1) << (w - 1), b);
+    if (w > 1) {
+      basic_big_integer b2 = b.square();
+      for (size_t i = 1; i < odd.size(); i++) {
+        odd[i] = odd[i - 1] * b2;
+      }
+    }
+
+    bool started = false;
+    for (size_t i = exp_bits; i != 0;) {
+      if (!((exp >> (i - 1)) & 1)) {
+        square_to(tmp, res);
+        std::swap(res, tmp);
+        i--;
+        continue;
+      }
+      size_t low = i > w ? i - w : 0;
+      while (!((exp >> low) & 1)) {
+        low++;
+      }
+      size_t window = static_cast<size_t>((exp >> low) & ((static_cast<uint64_t>(1) << (i - low)) - 1));
+      if (started) {
+        for (size_t j = low; j < i; j++) {
+          square_to(tmp, res);
+          std::swap(res, tmp);
+        }
+        mul_to(tmp, res, odd[window / 2]);
+        std::swap(res, tmp);
+      } else {
+        res.copy_from(odd[window / 2]);
+        started = true;
+      }
+      i = low;
+    }
+  }
+
+  res.sign = negative;
+  return res;
+}
+
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::factorial(uint32_t n) {
+  // n! = 2^(n - popcount(n)) * prod_j (odd numbers in (n >> (j + 1), n >> j])^(j + 1)
+  size_t twos = n;
+  for (uint32_t m = n; m != 0; m >>= 1) {
+    twos -= m & 1;
+  }
+
+  basic_big_integer odd_part = 1, partial = 1;
+  size_t levels = 0;
+  while ((n >> levels) > 2) {
+    levels++;
+  }
+  for (size_t j = levels; j != 0; j--) {
+    uint64_t lo = (n >> j) + 1, hi = (n >> (j - 1)) + 1;
+    std::vector<uint64_t> chunks = packed_range(lo | 1, hi, 2);
+    std::vector<basic_big_integer> leaves;
+    leaves.reserve(chunks.size());
+    for (uint64_t c : chunks) {
+      leaves.push_back(basic_big_integer::from_uint64(c));
+    }
+    partial *= product(leaves.begin(), leaves.end());
+    odd_part *= partial;
+  }
+
+  return odd_part << static_cast<int>(twos);
+}
+
+template<typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::binomial(uint32_t n, uint32_t k) {
+  if (k > n) {
+    return 0;
+  }
+  k = std::min(k, n - k);
+
+  std::vector<uint64_t> chunks = packed_range(static_cast<uint64_t>(n - k) + 1, static_cast<uint64_t>(n) + 1, 1);
+  std::vector<basic_big_integer> leaves;
+  leaves.reserve(chunks.size());
+  for (uint64_t c : chunks) {
+    leaves.push_back(basic_big_integer::from_uint64(c));
+  }
+  return product(leaves.begin(), leaves.end()) / factorial(k);
+}
+
+namespace {
+limbs mont_pow(montgomery& m, limbs const& base, limbs const& exp, limbs const& one) {
+  // fixed 4-bit window
+  std::vector<limbs> table(16, one);
+  for (size_t i = 1; i < table.size(); i++) {
+    m.mul(table[i], table[i - 1], base);
+  }
+
+  limbs res = one;
+  bool started = false;
+  for (size_t i = 8 * exp.size(); i != 0; i--) {
+    uint32_t window = (exp[(i - 1) / 8] >> (4 * ((i - 1) % 8))) & 15;
+    if (started) {
+      for (size_t j = 0; j < 4; j++) {
+        m.mul(res, res, res);
+      }
+      if (window != 0) {
+        m.mul(res, res, table[window]);
+      }
+    } else if (window != 0) {
+      res = table[window];
+      started = true;
+    }
+  }
+  return res;
+}
+
+bool strong_probable_prime(montgomery& m, limbs const& base, limbs const& d, size_t r,
+                           limbs const& one, limbs const& minus_one) {
+  limbs x = mont_pow(m, base, d, one);
+  if (x == one || x == minus_one) {
+    return true;
+  }
+  for (size_t i = 1; i < r; i++) {
+    m.mul(x, x, x);
+    if (x == minus_one) {
+      return true;
+    }
+    if (x == one) {
+      return false;
+    }
+  }
+  return false;
+}
+
+// strong Lucas test with P = 1, Q = (1 - D) / 4 on n + 1 = k * 2^s
+bool strong_lucas_probable_prime(montgomery& m, limbs const& d, limbs const& q, limbs const& k, size_t s,
+                                 limbs const& one) {
+  limbs zero(one.size(), 0), u = one, v = one, qk = q, tmp;
+
+  size_t top = 32 * k.size();
+  while (!((k[(top - 1) / 32] >> ((top - 1) % 32)) & 1)) {
+    top--;
+  }
+  for (size_t i = top - 1; i != 0; i--) {
+    m.mul(u, u, v);
+    m.mul(v, v, v);
+    m.sub(v, qk);
+    m.sub(v, qk);
+    m.mul(qk, qk, qk);
+
+    if ((k[(i - 1) / 32] >> ((i - 1) % 32)) & 1) {
+      m.mul(tmp, d, u);
+      m.add(tmp, v);
+      m.half(tmp);
+      m.add(u, v);
+      m.half(u);
+      v = tmp;
+      m.mul(qk, qk, q);
+    }
+  }
+
+  if (u == zero || v == zero) {
+    return true;
+  }
+  for (size_t r = 1; r < s; r++) {
+    m.mul(v, v, v);
+    m.sub(v, qk);
+    m.sub(v, qk);
+    if (v == zero) {
+      return true;
+    }
+    m.mul(qk, qk, qk);
+  }
+  return false;
+}
+}
+
+template<typename Storage>
+bool basic_big_integer<Storage>::is_probable_prime(basic_big_integer const& n, size_t rounds) {
+  if (n.sign || (n.size() == 1 && n[0] < 2)) {
+    return false;
+  }
+  if (n[0] % 2 == 0) {
+    return n.size() == 1 && n[0] == 2;
+  }
+
+  // one pass over the limbs per group of small primes
+  std::vector<uint32_t> const& primes = small_primes();
+  size_t first = 1;
+  for (auto const& group : prime_groups()) {
+    uint32_t r = n.short_mod(group.first);
+    for (size_t i = first; i < group.second; i++) {
+      if (r % primes[i] == 0) {
+        return n.size() == 1 && n[0] == primes[i];
+      }
+    }
+    first = group.second;
+  }
+  if (n.size() == 1 && n[0] < primes.back() * primes.back()) {
+    return true;
+  }
+
+  const_limb_span n_limbs = n.value.span();
+  size_t size = n_limbs.size;
+  montgomery m(limbs(n_limbs.data, n_limbs.data + size));
+
+  auto to_limbs = [size](basic_big_integer const& x) {
+    const_limb_span x_limbs = x.value.span();
+    limbs res(size, 0);
+    std::copy(x_limbs.data, x_limbs.data + x_limbs.size, res.begin());
+    return res;
+  };
+  auto to_montgomery = [&](int x) {
+    basic_big_integer y = x < 0 ? n + x : basic_big_integer(x);
+    return to_limbs((y << static_cast<int>(32 * size)) % n);
+  };
+
+  limbs one = to_montgomery(1), minus_one = to_montgomery(-1);
+
+  size_t r = 0;
+  basic_big_integer n_minus_one = n - 1;
+  while (!((n_minus_one[r / 32] >> (r % 32)) & 1)) {
+    r++;
+  }
+  limbs d = to_limbs(n_minus_one >> static_cast<int>(r));
+  if (!strong_probable_prime(m, to_montgomery(2), d, r, one, minus_one)) {
+    return false;
+  }
+  for (size_t i = 1; i <= rounds && i < primes.size(); i++) {
+    if (!strong_probable_prime(m, to_montgomery(static_cast<int>(primes[i])), d, r, one, minus_one)) {
+      return false;
+    }
+  }
+
+  if (is_square(n)) {
+    return false;
+  }
+
+  // Selfridge: first D in 5, -7, 9, -11, ... with (D / n) = -1
+  int disc = 5;
+  while (true) {
+    uint32_t abs_disc = static_cast<uint32_t>(disc < 0 ? -disc : disc);
+    int j = jacobi(n.short_mod(abs_disc), abs_disc);
+    if (abs_disc % 4 == 3 && n[0] % 4 == 3) {
+      j = -j;
+    }
+    if (disc < 0 && n[0] % 4 == 3) {
+      j = -j;
+    }
+    if (j == 0) {
+      return false;
+    }
+    if (j == -1) {
+      break;
+    }
+    disc = disc < 0 ? 2 - disc : -disc - 2;
+  }
+
+  size_t s = 0;
+  basic_big_integer n_plus_one = n + 1;
+  while (!((n_plus_one[s / 32] >> (s % 32)) & 1)) {
+    s++;
+  }
+  return strong_lucas_probable_prime(m, to_montgomery(disc), to_montgomery((1 - disc) / 4),
+                                     to_limbs(n_plus_one >> static_cast<int>(s)), s, one);
+}
+
+#define INSTANTIATE_MATH(Storage)                                                                                    \
+  template basic_big_integer<Storage> basic_big_integer<Storage>::iroot(basic_big_integer const&, uint32_t);         \
+  template bool basic_big_integer<Storage>::is_square(basic_big_integer const&);                                  \
+  template basic_big_integer<Storage> basic_big_integer<Storage>::gcd(basic_big_integer const&,                   \
+                                                                      basic_big_integer const&);                  \
+  template basic_big_integer<Storage> basic_big_integer<Storage>::pow(basic_big_integer const&, uint64_t);         \
+  template basic_big_integer<Storage> basic_big_integer<Storage>::factorial(uint32_t);                              \
+  template basic_big_integer<Storage> basic_big_integer<Storage>::binomial(uint32_t, uint32_t);                     \
+  template bool basic_big_integer<Storage>::is_probable_prime(basic_big_integer const&, size_t);
+
+INSTANTIATE_MATH(buffer)
+INSTANTIATE_MATH(vector_storage)
+INSTANTIATE_MATH(pooled_storage)
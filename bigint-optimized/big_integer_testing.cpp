@@ -2,12 +2,22 @@
 #include <cassert>
 #include <cstdlib>
 #include <random>
+#include <thread>
 #include <vector>
 #include <utility>
 #include <gtest/gtest.h>
 
 #include "big_integer.h"
+#include "big_integer_expr.h"
+#include "big_integer_literal.h"
 #include "big_integer_gmp.h"
+#include "big_decimal_integer.h"
+#include "big_float.h"
+#include "big_rational.h"
+#include "binary_splitting.h"
+#include "compact_big_integer.h"
+#include "constant_pool.h"
+#include "fixed_int.h"
 
 TEST(correctness, two_plus_two) {
   EXPECT_EQ(big_integer(4), big_integer(2) + big_integer(2));
@@ -402,6 +412,13 @@ TEST(correctness, shr_signed) {
   EXPECT_EQ(-155, a);
 }
 
+TEST(correctness, shr_signed_exact) {
+  EXPECT_EQ(-2, big_integer(-4) >> 1);
+  EXPECT_EQ(-1, big_integer(-1) >> 40);
+  EXPECT_EQ(big_integer("-4294967296"), big_integer("-18446744073709551616") >> 32);
+  EXPECT_EQ(big_integer("-4294967297"), big_integer("-18446744073709551617") >> 32);
+}
+
 TEST(correctness, shr_return_value) {
   big_integer a = 64;
 
@@ -509,6 +526,14 @@ TEST(correctness, div_long_signed2) {
   EXPECT_EQ(c, a / b);
 }
 
+TEST(correctness, div_long_trial_overflow) {
+  big_integer a("340282366920938462356569963009195114496"); // (2^64 - 60) * 2^64
+  big_integer b("18446744073709551557");                    // 2^64 - 59
+
+  EXPECT_EQ(big_integer("18446744073709551614"), a / b);
+  EXPECT_EQ(big_integer("18446744073709551498"), a % b);
+}
+
 TEST(correctness, negation_long) {
   big_integer a("10000000000000000000000000000000000000000000000000000");
   big_integer c("-10000000000000000000000000000000000000000000000000000");
@@ -656,6 +681,12 @@ big_integer rand_big(size_t size) {
 
   return result;
 }
+
+// rand_big of fewer than max_size steps with a random sign
+big_integer rand_signed_big(size_t max_size) {
+  big_integer a = rand_big(rand() % max_size);
+  return rand() % 2 ? -a : a;
+}
 }
 
 TEST(correctness, div_randomized) {
@@ -724,6 +755,18 @@ TEST(correctness_random, mul) {
   }
 }
 
+TEST(correctness_random, mul_long) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a, b;
+    a.random(max_size * 8, rng);
+    b.random(max_size * (itn + 1) / 2, rng);
+    big_integer A = big_integer(to_string(a)), B = big_integer(to_string(b));
+    EXPECT_EQ(to_string(a * b), to_string(A * B));
+    EXPECT_EQ(to_string(a * a), to_string(pow(A, 2)));
+  }
+}
+
 TEST(correctness_random, div) {
   std::default_random_engine rng(322);
   for (size_t itn = 0; itn != number_of_iterations; ++itn) {
@@ -786,6 +829,13 @@ TEST(correctness_random, bit_shifts) {
 
     EXPECT_EQ(to_string(a << shift), to_string(R << shift));
     EXPECT_EQ(to_string(a >> shift), to_string(R >> shift));
+
+    big_integer c = R;
+    c <<= shift;
+    EXPECT_EQ(to_string(a << shift), to_string(c));
+    c = R;
+    c >>= shift;
+    EXPECT_EQ(to_string(a >> shift), to_string(c));
   }
 }
 
@@ -815,3 +865,823 @@ TEST(correctness_twos_complement, all_ones) {
 
   EXPECT_EQ(to_string(gmp_ans), to_string(your_ans));
 }
+
+// roots
+
+TEST(correctness, isqrt) {
+  EXPECT_EQ(0, isqrt(0));
+  EXPECT_EQ(1, isqrt(3));
+  EXPECT_EQ(2, isqrt(4));
+  EXPECT_EQ(46340, isqrt(std::numeric_limits<int>::max()));
+  EXPECT_EQ(big_integer("1000000000000000000000"), isqrt(big_integer("1000000000000000000000000000000000000000000")));
+  EXPECT_THROW(isqrt(-1), std::domain_error);
+}
+
+TEST(correctness, iroot) {
+  EXPECT_EQ(3, iroot(27, 3));
+  EXPECT_EQ(2, iroot(26, 3));
+  EXPECT_EQ(-3, iroot(-27, 3));
+  EXPECT_EQ(2, iroot(big_integer("18446744073709551616"), 64));
+  EXPECT_EQ(1, iroot(big_integer("18446744073709551615"), 64));
+  EXPECT_THROW(iroot(-16, 4), std::domain_error);
+}
+
+TEST(correctness, roots_randomized) {
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_integer a = rand_big(itn + 1);
+    if (a < 0) {
+      a = -a;
+    }
+    for (uint32_t k = 2; k != 6; k++) {
+      big_integer r = iroot(a, k);
+      big_integer lo = 1, hi = 1;
+      for (uint32_t i = 0; i != k; i++) {
+        lo *= r;
+        hi *= r + 1;
+      }
+      EXPECT_LE(lo, a);
+      EXPECT_GT(hi, a);
+    }
+  }
+}
+
+TEST(correctness, is_square) {
+  EXPECT_TRUE(is_square(0));
+  EXPECT_TRUE(is_square(1));
+  EXPECT_FALSE(is_square(2));
+  EXPECT_FALSE(is_square(-4));
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_integer a = rand_big(itn + 1);
+    EXPECT_TRUE(is_square(a * a));
+    EXPECT_FALSE(is_square(a * a + 1));
+    EXPECT_FALSE(is_square(a * a * 4 + 8));
+  }
+}
+
+TEST(correctness, pow) {
+  EXPECT_EQ(1, pow(big_integer(0), 0));
+  EXPECT_EQ(0, pow(big_integer(0), 5));
+  EXPECT_EQ(-8, pow(big_integer(-2), 3));
+  EXPECT_EQ(16, pow(big_integer(-2), 4));
+  EXPECT_EQ(big_integer(1) << 640, pow(big_integer(1) << 64, 10));
+  EXPECT_EQ(big_integer("-1000000000000000000000000000000000000000"), pow(big_integer(-10), 39));
+  EXPECT_EQ(big_integer("1853020188851841"), pow(big_integer(9), 16));
+  EXPECT_EQ(1, pow(big_integer(-1), uint64_t(1) << 63));
+  EXPECT_THROW(pow(big_integer(4), uint64_t(1) << 63), std::length_error);
+  EXPECT_THROW(pow(big_integer(3), uint64_t(1) << 40), std::length_error);
+}
+
+TEST(correctness, pow_randomized) {
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer a = rand_big(itn % 3);
+    big_integer expected = 1;
+    for (uint64_t e = 0; e != 70; e++) {
+      EXPECT_EQ(expected, pow(a, e));
+      expected *= a;
+    }
+  }
+}
+
+TEST(correctness, product) {
+  std::vector<int> empty;
+  EXPECT_EQ(1, product(empty.begin(), empty.end()));
+
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    std::vector<big_integer> x;
+    big_integer expected = 1;
+    for (size_t i = 0; i != number_of_multipliers; ++i) {
+      x.emplace_back(myrand());
+      expected *= x.back();
+    }
+    EXPECT_EQ(expected, product(x.begin(), x.end()));
+  }
+}
+
+TEST(correctness, factorial) {
+  big_integer expected = 1;
+  for (uint32_t n = 0; n != 300; n++) {
+    if (n != 0) {
+      expected *= static_cast<int>(n);
+    }
+    EXPECT_EQ(expected, factorial(n));
+  }
+}
+
+TEST(correctness, binomial) {
+  std::vector<big_integer> row(1, 1);
+  for (uint32_t n = 0; n != 100; n++) {
+    for (uint32_t k = 0; k <= n; k++) {
+      EXPECT_EQ(row[k], binomial(n, k));
+    }
+    EXPECT_EQ(0, binomial(n, n + 1));
+    for (size_t k = row.size() - 1; k != 0; k--) {
+      row[k] += row[k - 1];
+    }
+    row.push_back(1);
+  }
+}
+
+TEST(correctness, is_probable_prime) {
+  std::vector<int> primes;
+  for (int n = -10; n != 20000; n++) {
+    bool prime = n >= 2;
+    for (int p : primes) {
+      if (p * p > n) {
+        break;
+      }
+      prime &= n % p != 0;
+    }
+    if (prime) {
+      primes.push_back(n);
+    }
+    EXPECT_EQ(prime, is_probable_prime(big_integer(n)));
+  }
+
+  EXPECT_TRUE(is_probable_prime(big_integer("170141183460469231731687303715884105727"))); // 2^127 - 1
+  EXPECT_TRUE(is_probable_prime(big_integer("18446744073709551557"), 5));
+  EXPECT_FALSE(is_probable_prime(big_integer("3825123056546413051"))); // strong pseudoprime to bases 2..23
+  EXPECT_FALSE(is_probable_prime(big_integer("318665857834031151167461"))); // strong pseudoprime to bases 2..37
+  EXPECT_FALSE(is_probable_prime(big_integer("170141183460469231731687303715884105727") *
+                                 big_integer("18446744073709551557")));
+}
+
+TEST(correctness_random, is_probable_prime) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a;
+    a.random(256, rng);
+    if (a < 0) {
+      a = -a;
+    }
+    big_integer A = big_integer(to_string(a));
+    for (int i = 0; i != 50; i++) {
+      EXPECT_EQ(is_probable_prime(a + i), is_probable_prime(A + i));
+    }
+  }
+}
+
+// lazy expressions
+
+TEST(correctness, lazy_expression) {
+  big_integer a = 5, b = 7, c = -3, d = 11, e = 100;
+  big_integer r;
+
+  r = lazy(a) * b + c;
+  EXPECT_EQ(32, r);
+  r = lazy(a) * b + c * d - e;
+  EXPECT_EQ(-98, r);
+  r = lazy(a) - (lazy(b) - c);
+  EXPECT_EQ(-5, r);
+
+  big_integer converted = lazy(a) * b;
+  EXPECT_EQ(35, converted);
+}
+
+TEST(correctness, lazy_expression_aliasing) {
+  big_integer a = 5, b = 7;
+
+  a = lazy(b) * a + a;
+  EXPECT_EQ(40, a);
+  a = lazy(a) * a;
+  EXPECT_EQ(1600, a);
+  b = lazy(b) - b;
+  EXPECT_EQ(0, b);
+}
+
+TEST(correctness, lazy_expression_randomized) {
+  big_integer r;
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_integer a = rand_big(itn % 7), b = rand_big(itn % 5), c = rand_big(itn % 11), d = rand_big(3);
+    big_integer e = rand_big(itn % 13);
+
+    r = lazy(a) * b + c * d - e;
+    EXPECT_EQ(a * b + c * d - e, r);
+    r = lazy(a) * b * c - (lazy(d) + e) * a;
+    EXPECT_EQ(a * b * c - (d + e) * a, r);
+  }
+}
+
+// output parameter arithmetic
+
+TEST(correctness, output_parameters) {
+  big_integer a = 17, b = -5, r, q;
+
+  add(r, a, b);
+  EXPECT_EQ(12, r);
+  sub(r, a, b);
+  EXPECT_EQ(22, r);
+  mul(r, a, b);
+  EXPECT_EQ(-85, r);
+  divmod(q, r, a, b);
+  EXPECT_EQ(-3, q);
+  EXPECT_EQ(2, r);
+
+  addmul(r, a, b);
+  EXPECT_EQ(-83, r);
+  submul(r, a, b);
+  EXPECT_EQ(2, r);
+}
+
+TEST(correctness, output_parameters_aliasing) {
+  big_integer a = 17, b = -5;
+
+  sub(b, a, b);
+  EXPECT_EQ(22, b);
+  add(a, a, a);
+  EXPECT_EQ(34, a);
+  mul(a, a, b);
+  EXPECT_EQ(748, a);
+  addmul(a, a, a);
+  EXPECT_EQ(560252, a);
+  divmod(a, b, a, b);
+  EXPECT_EQ(25466, a);
+  EXPECT_EQ(0, b);
+}
+
+TEST(correctness, output_parameters_randomized) {
+  big_integer acc, expected, q, r, tmp;
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_integer a = rand_big(itn % 7), b = rand_big(itn % 5), c = rand_big(itn % 11);
+
+    add(tmp, a, c);
+    EXPECT_EQ(a + c, tmp);
+    sub(tmp, b, c);
+    EXPECT_EQ(b - c, tmp);
+    mul(tmp, a, b);
+    EXPECT_EQ(a * b, tmp);
+    divmod(q, r, c, b);
+    EXPECT_EQ(c / b, q);
+    EXPECT_EQ(c % b, r);
+
+    addmul(acc, a, b);
+    expected += a * b;
+    EXPECT_EQ(expected, acc);
+    submul(acc, c, b);
+    expected -= c * b;
+    EXPECT_EQ(expected, acc);
+  }
+}
+
+// limb storage
+
+TEST(correctness, limb_pool_steady_state) {
+  big_integer a = rand_big(20), b = rand_big(30), r;
+  for (size_t i = 0; i != 10; ++i) {
+    r = a * b + a;
+    r = r / a;
+  }
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  for (size_t i = 0; i != 100; ++i) {
+    r = a * b + a;
+    r = r / a;
+  }
+  limb_pool::statistics after = limb_pool::thread_statistics();
+
+  EXPECT_GT(after.requests, before.requests);
+  EXPECT_EQ(before.system_allocations, after.system_allocations);
+}
+
+TEST(correctness, copy_assignment_shares_limbs) {
+  big_integer a = rand_big(50), b = rand_big(40), c;
+  std::string expected = to_string(a);
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  for (size_t i = 0; i != 100; ++i) {
+    b = a;
+    c = b;
+    b = b;
+    a = c;
+  }
+  limb_pool::statistics after = limb_pool::thread_statistics();
+
+  EXPECT_EQ(before.requests, after.requests);
+  EXPECT_EQ(to_string(a), expected);
+  EXPECT_EQ(to_string(c), expected);
+
+  b += 1;
+  EXPECT_EQ(to_string(a), expected);
+  EXPECT_EQ(b - 1, c);
+}
+
+TEST(correctness, reserved_accumulator) {
+  big_integer acc, x = rand_big(40);
+  acc.reserve(64);
+  EXPECT_GE(acc.capacity(), 64u);
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  for (size_t i = 0; i != 100; ++i) {
+    acc += x;
+  }
+  limb_pool::statistics after = limb_pool::thread_statistics();
+
+  EXPECT_EQ(before.requests, after.requests);
+  EXPECT_EQ(acc, x * 100);
+}
+
+TEST(correctness, shared_limbs_across_threads) {
+  big_integer const constant = rand_big(100);
+  std::string expected = to_string(constant);
+  // rendered for the first time by all threads at once
+  big_integer const next = constant + 1;
+  std::string next_expected = to_string(constant + 1);
+
+  std::vector<int> ok(4);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t != ok.size(); ++t) {
+    workers.emplace_back([&constant, &next, &next_expected, &ok, t] {
+      bool good = to_string(next) == next_expected;
+      for (size_t i = 0; i != 1000; ++i) {
+        big_integer copy = constant;
+        big_integer changed = copy;
+        changed += 1;
+        good &= copy == constant && changed - 1 == constant;
+      }
+      ok[t] = good;
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (int good : ok) {
+    EXPECT_TRUE(good);
+  }
+  EXPECT_EQ(to_string(constant), expected);
+}
+
+TEST(correctness, whole_limb_shifts_in_place) {
+  big_integer x = rand_big(20), y = x;
+  y += 0;  // y gets limbs of its own
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  y >>= 64;
+  y <<= 64;
+  limb_pool::statistics after = limb_pool::thread_statistics();
+
+  EXPECT_EQ(before.requests, after.requests);
+  EXPECT_EQ(y, (x >> 64) << 64);
+  EXPECT_EQ(x - y, x & ((big_integer(1) << 64) - 1));
+}
+
+TEST(correctness, limb_pool_cross_thread_free) {
+  std::vector<big_integer> numbers;
+  limb_pool::statistics allocated{0, 0};
+  std::thread producer([&numbers, &allocated] {
+    for (size_t i = 0; i != 100; ++i) {
+      numbers.push_back(rand_big(i % 10 + 3));
+    }
+    allocated = limb_pool::thread_statistics();
+  });
+  producer.join();
+
+  // the producer's own cache was empty, so its limbs came from the system
+  EXPECT_GT(allocated.requests, 0u);
+  EXPECT_GT(allocated.system_allocations, 0u);
+
+  // blocks freed by another thread go to that thread's cache and are reused there
+  limb_pool::statistics main_before = limb_pool::thread_statistics();
+  limb_pool::statistics freed{0, 0}, reused{0, 0};
+  std::thread consumer([&numbers, &freed, &reused] {
+    numbers.clear();
+    freed = limb_pool::thread_statistics();
+    std::vector<big_integer> more;
+    for (size_t i = 0; i != 40; ++i) {
+      more.push_back(rand_big(i % 10 + 3));
+    }
+    reused = limb_pool::thread_statistics();
+  });
+  consumer.join();
+  limb_pool::statistics main_after = limb_pool::thread_statistics();
+
+  EXPECT_EQ(0u, freed.requests);
+  EXPECT_GT(reused.requests, freed.requests);
+  EXPECT_EQ(freed.system_allocations, reused.system_allocations);
+  EXPECT_EQ(main_before.requests, main_after.requests);
+  EXPECT_EQ(main_before.system_allocations, main_after.system_allocations);
+}
+
+TEST(correctness, compact_inline_range) {
+  EXPECT_EQ(8u, sizeof(compact_big_integer));
+
+  compact_big_integer max(compact_big_integer::INLINE_MAX), min(compact_big_integer::INLINE_MIN);
+  EXPECT_TRUE(max.is_inline());
+  EXPECT_TRUE(min.is_inline());
+  EXPECT_FALSE((max + 1).is_inline());
+  EXPECT_FALSE((min - 1).is_inline());
+  EXPECT_FALSE((min / -1).is_inline());
+  EXPECT_TRUE((max + 1 - 1).is_inline());
+  EXPECT_EQ(max + 1 - 1, max);
+  EXPECT_LT(min - 1, min);
+  EXPECT_GT(max + 1, max);
+  EXPECT_EQ(to_string(max + 1), "2305843009213693952");
+  EXPECT_EQ(to_string(min - 1), "-2305843009213693953");
+  EXPECT_EQ(compact_big_integer(INT64_MIN).to_big_integer(), big_integer(INT32_MIN) * (big_integer(1) << 32));
+  EXPECT_EQ(compact_big_integer("-2305843009213693952"), min);
+}
+
+TEST(correctness_random, compact_arithmetic) {
+  for (size_t itn = 0; itn != number_of_iterations * number_of_multipliers; ++itn) {
+    big_integer a = rand_signed_big(3), b = rand_signed_big(3);
+    compact_big_integer x(a), y(b);
+    EXPECT_EQ((x + y).to_big_integer(), a + b);
+    EXPECT_EQ((x - y).to_big_integer(), a - b);
+    EXPECT_EQ((x * y).to_big_integer(), a * b);
+    EXPECT_EQ(x * y, compact_big_integer(a * b));
+    if (b != 0) {
+      EXPECT_EQ((x / y).to_big_integer(), a / b);
+      EXPECT_EQ((x % y).to_big_integer(), a % b);
+    }
+    EXPECT_EQ(x < y, a < b);
+    EXPECT_EQ(x == y, a == b);
+    EXPECT_EQ(to_string(x), to_string(a));
+  }
+}
+
+TEST(correctness, fixed_int_constexpr) {
+  constexpr int256 a = (int256(1) << 200) - 1;
+  constexpr int256 b = a * a;
+  static_assert(b == (int256(1) << 201) * -1 + 1, "wraps modulo 2^256");
+  static_assert(int256(-7) / 2 == -3 && int256(-7) % 2 == -1, "division truncates");
+  static_assert(int256(-7) >> 1 == -4, "right shift rounds down");
+  static_assert(uint128(-1) > uint128(1) && int128(-1) < int128(1), "signedness only changes the order");
+  static_assert(uint128(-1) + 1 == 0, "unsigned wraps");
+  static_assert(uint256(-1) / uint256(1000000007) * 1000000007 + uint256(-1) % 1000000007 == uint256(-1), "");
+
+  EXPECT_EQ(to_string(a), to_string((big_integer(1) << 200) - 1));
+  EXPECT_EQ(to_string(uint128(-1)), "340282366920938463463374607431768211455");
+  EXPECT_EQ(to_string(int128(-1) << 127), "-170141183460469231731687303715884105728");
+  EXPECT_EQ(int128(-1) << 127, (int128(-1) << 127) / -1);
+  EXPECT_THROW(int128(1) / 0, std::domain_error);
+}
+
+TEST(correctness_random, fixed_int_matches_big_integer) {
+  for (size_t itn = 0; itn != number_of_iterations * number_of_multipliers; ++itn) {
+    big_integer a = rand_signed_big(8), b = rand_signed_big(8);
+    int shift = rand() % 300;
+    int256 x(a), y(b);
+    EXPECT_EQ(x.to_big_integer(), a);
+    EXPECT_EQ(x + y, int256(a + b));
+    EXPECT_EQ(x - y, int256(a - b));
+    EXPECT_EQ(x * y, int256(a * b));
+    EXPECT_EQ(x & y, int256(a & b));
+    EXPECT_EQ(x | y, int256(a | b));
+    EXPECT_EQ(x ^ y, int256(a ^ b));
+    EXPECT_EQ(~x, int256(~a));
+    EXPECT_EQ(x << shift, int256(a << shift));
+    EXPECT_EQ(x >> shift, int256(a >> shift));
+    EXPECT_EQ(x << -shift, int256(a >> shift));
+    EXPECT_EQ(x >> -shift, int256(a << shift));
+    EXPECT_EQ(x < y, a < b);
+    if (b != 0) {
+      EXPECT_EQ((x / y).to_big_integer(), a / b);
+      EXPECT_EQ((x % y).to_big_integer(), a % b);
+    }
+  }
+}
+
+TEST(correctness, literal) {
+  EXPECT_EQ(0_bi, 0);
+  EXPECT_EQ(-42_bi, -42);
+  EXPECT_EQ(123456789012345678901234567890_bi, big_integer("123456789012345678901234567890"));
+  EXPECT_EQ(0xffff'ffff'ffff'ffff'ffff_bi, (big_integer(1) << 80) - 1);
+  EXPECT_EQ(0XaBc_bi, 2748);
+  EXPECT_EQ(0b1000000000000000000000000000000000_bi, big_integer(1) << 33);
+  EXPECT_EQ(0777_bi, 511);
+  EXPECT_EQ(1'000'000'000'000_bi, big_integer(1000000) * 1000000);
+}
+
+TEST(correctness, literal_shares_limbs) {
+  auto constant = [] {
+    return 340282366920938463463374607431768211457340282366920938463463374607431768211457_bi;
+  };
+  big_integer first = constant();
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  for (size_t i = 0; i != 100; ++i) {
+    EXPECT_EQ(constant(), first);
+  }
+  limb_pool::statistics after = limb_pool::thread_statistics();
+#if BIGINT_ATOMIC_REFCOUNT
+  EXPECT_EQ(before.requests, after.requests);
+#else
+  EXPECT_GT(after.requests, before.requests);
+#endif
+
+  big_integer changed = constant();
+  changed += 1;
+  EXPECT_EQ(changed - 1, constant());
+  EXPECT_EQ(to_string(constant()), "340282366920938463463374607431768211457340282366920938463463374607431768211457");
+}
+
+TEST(correctness, decimal_text) {
+  std::string s = "-1000000000000000000000000000000000000001";
+  EXPECT_EQ(to_string(big_decimal_integer(s)), s);
+  EXPECT_EQ(to_string(big_decimal_integer("+000123")), "123");
+  EXPECT_EQ(to_string(big_decimal_integer("-0")), "0");
+  EXPECT_EQ(to_string(big_decimal_integer(INT32_MIN)), "-2147483648");
+  EXPECT_EQ(big_decimal_integer(big_integer(s)).to_big_integer(), big_integer(s));
+  EXPECT_EQ(big_decimal_integer(999999999) + 1, big_decimal_integer("1000000000"));
+  EXPECT_EQ(big_decimal_integer("1000000000000000000") - 1, big_decimal_integer("999999999999999999"));
+}
+
+TEST(correctness_random, decimal_matches_big_integer) {
+  for (size_t itn = 0; itn != number_of_iterations * number_of_multipliers; ++itn) {
+    big_integer a = rand_signed_big(12), b = rand_signed_big(12);
+    big_decimal_integer x(a), y(b);
+    EXPECT_EQ(to_string(x), to_string(a));
+    EXPECT_EQ(big_decimal_integer(to_string(a)), x);
+    EXPECT_EQ((x + y).to_big_integer(), a + b);
+    EXPECT_EQ((x - y).to_big_integer(), a - b);
+    EXPECT_EQ((x * y).to_big_integer(), a * b);
+    if (b != 0) {
+      EXPECT_EQ((x / y).to_big_integer(), a / b);
+      EXPECT_EQ((x % y).to_big_integer(), a % b);
+    }
+    EXPECT_EQ(x < y, a < b);
+  }
+}
+
+TEST(correctness, cached_decimal) {
+  big_integer a = rand_big(100);
+  std::string digits = to_string(a);
+  big_integer b = a, c = -a;
+  EXPECT_EQ(to_string(b), digits);
+  EXPECT_EQ(to_string(c), '-' + digits);
+
+  b += 1;
+  EXPECT_EQ(b, big_integer(to_string(b)));
+  EXPECT_EQ(to_string(a), digits);
+
+  // unique numbers change their limbs in place
+  big_integer d = rand_big(100);
+  d += 0;
+  std::string before = to_string(d);
+  d *= 10;
+  EXPECT_EQ(to_string(d), before + "0");
+  d >>= 64;
+  EXPECT_EQ(d, big_integer(to_string(d)));
+  d <<= 64;
+  EXPECT_EQ(d, big_integer(to_string(d)));
+  d -= 1;
+  EXPECT_EQ(d, big_integer(to_string(d)));
+}
+
+TEST(correctness, constant_pool) {
+  typedef constant_pool<big_integer> pool;
+  EXPECT_EQ(pool::small(-128), -128);
+  EXPECT_EQ(pool::small(1024), 1024);
+  EXPECT_EQ(&pool::small(7), &pool::small(7));
+  EXPECT_EQ(pool::power_of_ten(3), big_integer(100000000));
+  EXPECT_EQ(pool::power_of_ten(10), pow(big_integer(10), 1024));
+  EXPECT_EQ(pool::power_of_two(10), big_integer(1) << 1024);
+  EXPECT_EQ(&pool::power_of_ten(10), &pool::power_of_ten(10));
+
+  limb_pool::statistics before = limb_pool::thread_statistics();
+  big_integer copy = pool::power_of_ten(10);
+  limb_pool::statistics after = limb_pool::thread_statistics();
+  EXPECT_EQ(before.requests, after.requests);
+  copy += 1;
+  EXPECT_EQ(copy - 1, pool::power_of_ten(10));
+}
+
+TEST(correctness, constant_pool_across_threads) {
+  std::vector<std::string> seen(4);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t != seen.size(); ++t) {
+    workers.emplace_back([&seen, t] {
+      seen[t] = to_string(constant_pool<big_integer>::power_of_ten(12));
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (std::string const& s : seen) {
+    EXPECT_EQ(s, "1" + std::string(4096, '0'));
+  }
+}
+
+TEST(correctness_random, radix_conversion) {
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    size_t digits = 1 + static_cast<size_t>(rand()) % 5000;
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rand() % 10);
+    }
+    s[0] = static_cast<char>('1' + rand() % 9);
+    big_integer a(s);
+    EXPECT_EQ(to_string(a), s);
+    EXPECT_EQ(to_string(-a), '-' + s);
+    EXPECT_EQ(big_integer("000" + s), a);
+    EXPECT_EQ(to_string(a), to_string(big_integer_gmp(s)));
+  }
+}
+
+TEST(correctness, gcd) {
+  EXPECT_EQ(gcd(big_integer(0), big_integer(0)), 0);
+  EXPECT_EQ(gcd(big_integer(0), big_integer(-5)), 5);
+  EXPECT_EQ(gcd(big_integer(-12), big_integer(18)), 6);
+  big_integer fib_a = 1, fib_b = 1;
+  for (size_t i = 0; i != 500; ++i) {
+    big_integer next = fib_a + fib_b;
+    fib_a = fib_b;
+    fib_b = next;
+  }
+  EXPECT_EQ(gcd(fib_a, fib_b), 1);
+  EXPECT_EQ(gcd(factorial(300), pow(big_integer(2), 1000)), pow(big_integer(2), 296));
+}
+
+TEST(correctness_random, gcd_matches_euclid) {
+  for (size_t itn = 0; itn != number_of_iterations * number_of_multipliers; ++itn) {
+    big_integer g = rand_big(1 + rand() % 6);
+    big_integer a = g * rand_big(rand() % 10), b = g * rand_big(rand() % 10);
+    big_integer x = a, y = b;
+    while (y != 0) {
+      big_integer t = x % y;
+      x = y;
+      y = t;
+    }
+    EXPECT_EQ(gcd(a, b), x < 0 ? -x : x);
+    EXPECT_EQ(gcd(b, -a), gcd(a, b));
+  }
+}
+
+TEST(correctness, rational) {
+  EXPECT_EQ(to_string(big_rational(6, -4)), "-3/2");
+  EXPECT_EQ(to_string(big_rational("10/5")), "2");
+  EXPECT_EQ(to_string(big_rational(0, -7)), "0");
+  EXPECT_EQ(big_rational(1, 3) + big_rational(1, 6), big_rational(1, 2));
+  EXPECT_EQ(big_rational(2, 3) * big_rational(9, 4), big_rational(3, 2));
+  EXPECT_EQ(big_rational(2, 3) / big_rational(-4, 9), big_rational(-3, 2));
+  EXPECT_LT(big_rational(-1, 2), big_rational(1, 3));
+  EXPECT_LT(big_rational(1, 3), big_rational(1, 2));
+  EXPECT_GT(big_rational(-1, 3), big_rational(-1, 2));
+  EXPECT_THROW(big_rational(1, 0), std::domain_error);
+  EXPECT_THROW(big_rational(1) / big_rational(0), std::domain_error);
+
+  big_rational h = 0;
+  for (int i = 1; i <= 10; ++i) {
+    h += big_rational(1, i);
+  }
+  EXPECT_EQ(to_string(h), "7381/2520");
+  EXPECT_EQ(h.numerator(), 7381);
+  EXPECT_TRUE(h.is_reduced());
+
+  // products of reduced fractions cancel crosswise and stay reduced
+  big_rational a(10, 21), b(14, 15);
+  a.reduce();
+  b.reduce();
+  big_rational p = a * b;
+  EXPECT_TRUE(p.is_reduced());
+  EXPECT_EQ(to_string(p), "4/9");
+
+  big_rational q = big_rational(1, 6) + big_rational(1, 10);
+  EXPECT_FALSE(q.is_reduced());
+  q.reduce();
+  EXPECT_EQ(to_string(q), "4/15");
+}
+
+TEST(correctness_random, rational_lazy_matches_eager) {
+  auto rand_fraction = [] {
+    big_integer den = rand_big(1 + rand() % 3);
+    return big_rational(rand() % 2 ? -rand_big(rand() % 3) : rand_big(rand() % 3), den == 0 ? 1 : den);
+  };
+
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_rational lazy = rand_fraction(), eager = lazy;
+    for (size_t step = 0; step != 50; ++step) {
+      big_rational x = rand_fraction();
+      int op = rand() % 4;
+      if (op == 3 && x == 0) {
+        op = 0;
+      }
+      switch (op) {
+        case 0:
+          lazy += x;
+          eager += x;
+          break;
+        case 1:
+          lazy -= x;
+          eager -= x;
+          break;
+        case 2:
+          lazy *= x;
+          eager *= x;
+          break;
+        default:
+          lazy /= x;
+          eager /= x;
+      }
+      eager.reduce();
+      EXPECT_TRUE(eager.is_reduced());
+    }
+    EXPECT_EQ(lazy, eager);
+    EXPECT_EQ(gcd(lazy.numerator(), lazy.denominator()), 1);
+    EXPECT_EQ(to_string(lazy), to_string(eager));
+    EXPECT_EQ(lazy * lazy.denominator(), lazy.numerator());
+  }
+}
+
+TEST(correctness, big_float) {
+  big_float tenth("0.1", 53);
+  EXPECT_EQ(tenth.mantissa(), big_integer("3602879701896397"));
+  EXPECT_EQ(tenth.exponent(), -55);
+  EXPECT_EQ(tenth.to_double(), 0.1);
+  EXPECT_EQ(to_string(big_float(1, 64) / big_float(3, 64)), "0.33333333333333333334");
+  EXPECT_EQ(to_string(big_float("-12.5e-3")), "-0.0125");
+  EXPECT_EQ(to_string(big_float(1000)), "1000");
+  EXPECT_EQ(to_string(big_float("6.02214076e23", 53)), "6.02214076e23");
+  EXPECT_EQ(to_string(sqrt(big_float(2, 200)), 40), "1.41421356237309504880168872420969807857");
+  EXPECT_EQ(sqrt(big_float(1024)), big_float(32));
+  EXPECT_EQ(big_float(big_integer(1), -3, 10), big_float(0.125));
+  EXPECT_EQ(big_float(7.75).to_big_integer(), 7);
+  EXPECT_EQ(big_float(-7.75).to_big_integer(), -7);
+  EXPECT_LT(big_float(-2), big_float(1.5));
+  EXPECT_LT(big_float(1.25), big_float(1.5));
+  EXPECT_GT(big_float(-1.25), big_float(-1.5));
+
+  // the smaller summand only decides the rounding
+  big_float one(1, 10);
+  big_float tiny(big_integer(1), -1000, 10);
+  EXPECT_EQ(one + tiny, one);
+  EXPECT_EQ(one - tiny, one);
+  EXPECT_EQ(big_float::sub(big_float(big_integer(1025), 0, 11), tiny, 10), big_float(1024));
+  EXPECT_EQ(big_float::add(big_float(big_integer(1025), 0, 11), tiny, 10), big_float(1026));
+
+  EXPECT_THROW(big_float(1) / big_float(0), std::domain_error);
+  EXPECT_THROW(sqrt(big_float(-1)), std::domain_error);
+  EXPECT_THROW(big_float("1.5x"), std::invalid_argument);
+}
+
+TEST(correctness_random, big_float_matches_double) {
+  std::default_random_engine rng(7);
+  std::uniform_real_distribution<double> mantissa(-1, 1);
+  std::uniform_int_distribution<int> exponent(-60, 60);
+  for (size_t itn = 0; itn != number_of_iterations * number_of_multipliers; ++itn) {
+    double a = std::ldexp(mantissa(rng), exponent(rng)), b = std::ldexp(mantissa(rng), exponent(rng));
+    big_float x(a, 53), y(b, 53);
+    EXPECT_EQ((x + y).to_double(), a + b);
+    EXPECT_EQ((x - y).to_double(), a - b);
+    EXPECT_EQ((x * y).to_double(), a * b);
+    if (b != 0) {
+      EXPECT_EQ((x / y).to_double(), a / b);
+    }
+    EXPECT_EQ(sqrt(big_float(std::fabs(a), 53)).to_double(), std::sqrt(std::fabs(a)));
+    EXPECT_EQ(x < y, a < b);
+    EXPECT_EQ(big_float(to_string(x, 17), 53), x);
+  }
+}
+
+// results of the Newton paths lie within half a unit in the last place of the exact value
+TEST(correctness_random, big_float_newton) {
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    size_t precision = 3000 + static_cast<size_t>(rand()) % 6000;
+    big_float a(rand_big(100 + rand() % 200), precision), b(rand_big(100 + rand() % 200), precision);
+    if (a.mantissa() < 0) {
+      a = -a;
+    }
+    if (b.mantissa() < 0) {
+      b = -b;
+    }
+    if (b == 0 || a == 0) {
+      continue;
+    }
+    size_t exact = 4 * precision;
+
+    big_float half(0.5);
+    big_float q = a / b;
+    big_float half_ulp = big_float::mul(q.ulp(), half, exact);
+    EXPECT_LE(big_float::mul(big_float::sub(q, half_ulp, exact), b, exact), a);
+    EXPECT_GE(big_float::mul(big_float::add(q, half_ulp, exact), b, exact), a);
+
+    big_float r = sqrt(a);
+    half_ulp = big_float::mul(r.ulp(), half, exact);
+    big_float lo = big_float::sub(r, half_ulp, exact), hi = big_float::add(r, half_ulp, exact);
+    EXPECT_LE(big_float::mul(lo, lo, exact), a);
+    EXPECT_GE(big_float::mul(hi, hi, exact), a);
+  }
+}
+
+TEST(correctness, binary_splitting) {
+  EXPECT_EQ(pi_digits<big_integer>(50), "3.14159265358979323846264338327950288419716939937510");
+  EXPECT_EQ(e_digits<big_integer>(50), "2.71828182845904523536028747135266249775724709369995");
+  EXPECT_EQ(ln2_digits<big_integer>(50), "0.69314718055994530941723212145817656807550013436025");
+  EXPECT_EQ(pi_digits<big_integer>(0), "3");
+
+  // sum 1 / n! for n < 10 summed term by term
+  split_sums<big_integer> s = binary_split<big_integer>(e_series<big_integer>(), 0, 10);
+  big_integer sum = 0, factorial = 1;
+  for (int n = 9; n >= 0; --n) {
+    sum += factorial;
+    factorial *= std::max(n, 1);
+  }
+  EXPECT_EQ(s.p, 1);
+  EXPECT_EQ(s.q, factorial);
+  EXPECT_EQ(s.t, sum);
+}
+
+TEST(correctness, binary_splitting_matches_gmp) {
+  EXPECT_EQ(pi_digits<big_integer>(3000), pi_digits<big_integer_gmp>(3000));
+  EXPECT_EQ(e_digits<big_integer>(3000), e_digits<big_integer_gmp>(3000));
+  EXPECT_EQ(ln2_digits<big_integer>(3000), ln2_digits<big_integer_gmp>(3000));
+}
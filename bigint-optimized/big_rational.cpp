@@ -0,0 +1,194 @@
+#include <stdexcept>
+#include "big_rational.h"
+
+namespace {
+bool is_one(big_integer const& a) {
+  return !a.sign && a == 1;
+}
+}
+
+constexpr size_t big_rational::REDUCE_MIN_LIMBS;
+
+big_rational::big_rational() : num(0), den(1), reduced(true), reduced_limbs(2) {}
+
+big_rational::big_rational(int a) : num(a), den(1), reduced(true), reduced_limbs(2) {}
+
+big_rational::big_rational(big_integer const& a) : num(a), den(1), reduced(true), reduced_limbs(limbs()) {}
+
+big_rational::big_rational(big_integer const& num, big_integer const& den) : num(num), den(den) {
+  if (this->den.is_zero()) {
+    throw std::domain_error("big_rational with zero denominator");
+  }
+  if (this->den.sign) {
+    this->num = -this->num;
+    this->den = -this->den;
+  }
+  if (this->num.is_zero()) {
+    this->den = 1;
+  }
+  reduced = is_one(this->den);
+  reduced_limbs = limbs();
+}
+
+big_rational::big_rational(std::string const& str) : big_rational() {
+  size_t slash = str.find('/');
+  *this = slash == std::string::npos
+          ? big_rational(big_integer(str))
+          : big_rational(big_integer(str.substr(0, slash)), big_integer(str.substr(slash + 1)));
+}
+
+big_integer const& big_rational::numerator() const {
+  reduce();
+  return num;
+}
+
+big_integer const& big_rational::denominator() const {
+  reduce();
+  return den;
+}
+
+void big_rational::reduce() const {
+  if (reduced) {
+    return;
+  }
+  big_integer g = gcd(num, den);
+  if (!is_one(g)) {
+    num /= g;
+    den /= g;
+  }
+  reduced = true;
+  reduced_limbs = limbs();
+}
+
+bool big_rational::is_reduced() const {
+  return reduced;
+}
+
+size_t big_rational::limbs() const {
+  return num.size() + den.size();
+}
+
+void big_rational::set_reduced(bool value) {
+  if (num.is_zero()) {
+    den = 1;
+    value = true;
+  }
+  reduced = value;
+  if (reduced) {
+    reduced_limbs = limbs();
+  }
+}
+
+void big_rational::reduce_if_grown() {
+  size_t n = limbs();
+  if (!reduced && n > REDUCE_MIN_LIMBS && n > 2 * reduced_limbs) {
+    reduce();
+  }
+}
+
+// a / b + c / d, whole summands keep the other one's reduction
+void big_rational::add_signed(big_rational const& b, bool negate) {
+  big_integer c = negate ? -b.num : b.num;
+  big_integer d = b.den;
+  if (is_one(d)) {
+    num += c * den;
+    set_reduced(reduced);
+  } else if (is_one(den)) {
+    num = num * d + c;
+    den = d;
+    set_reduced(b.reduced);
+  } else if (den == d) {
+    num += c;
+    set_reduced(false);
+  } else {
+    num = num * d + c * den;
+    den *= d;
+    set_reduced(false);
+  }
+  reduce_if_grown();
+}
+
+big_rational& big_rational::operator+=(big_rational const& a) {
+  add_signed(a, false);
+  return *this;
+}
+
+big_rational& big_rational::operator-=(big_rational const& a) {
+  add_signed(a, true);
+  return *this;
+}
+
+// (a / b) * (c / d) = (a / gcd(a, d)) * (c / gcd(c, b)) / ((b / gcd(c, b)) * (d / gcd(a, d)))
+big_rational& big_rational::operator*=(big_rational const& a) {
+  big_integer c = a.num, d = a.den;
+  bool cancel = reduced && a.reduced;
+  if (cancel && !is_one(d)) {
+    big_integer g = gcd(num, d);
+    if (!is_one(g)) {
+      num /= g;
+      d /= g;
+    }
+  }
+  if (cancel && !is_one(den)) {
+    big_integer g = gcd(c, den);
+    if (!is_one(g)) {
+      c /= g;
+      den /= g;
+    }
+  }
+  num *= c;
+  den *= d;
+  set_reduced(cancel);
+  reduce_if_grown();
+  return *this;
+}
+
+big_rational& big_rational::operator/=(big_rational const& a) {
+  if (a.num.is_zero()) {
+    throw std::domain_error("big_rational division by zero");
+  }
+  big_rational inverse;
+  inverse.num = a.den;
+  inverse.den = a.num;
+  if (inverse.den.sign) {
+    inverse.den.sign = false;
+    inverse.num.sign = true;
+  }
+  inverse.reduced = a.reduced;
+  inverse.reduced_limbs = a.reduced_limbs;
+  return *this *= inverse;
+}
+
+big_rational big_rational::operator+() const {
+  return *this;
+}
+
+big_rational big_rational::operator-() const {
+  big_rational res(*this);
+  res.num = -res.num;
+  return res;
+}
+
+bool big_rational::equals(big_rational const& b) const {
+  reduce();
+  b.reduce();
+  return num == b.num && den == b.den;
+}
+
+int32_t big_rational::compare(big_rational const& b) const {
+  reduce();
+  b.reduce();
+  if (num.sign != b.num.sign) {
+    return num.sign ? -1 : 1;
+  }
+  if (den == b.den) {
+    return num < b.num ? -1 : num > b.num;
+  }
+  big_integer left = num * b.den, right = b.num * den;
+  return left < right ? -1 : left > right;
+}
+
+std::string to_string(big_rational const& a) {
+  a.reduce();
+  return is_one(a.den) ? to_string(a.num) : to_string(a.num) + "/" + to_string(a.den);
+}
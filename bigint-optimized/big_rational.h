@@ -0,0 +1,100 @@
+#ifndef BIGINT__BIG_RATIONAL_H_
+#define BIGINT__BIG_RATIONAL_H_
+
+#include <ostream>
+#include <string>
+#include "big_integer.h"
+
+// Fraction of two big_integers, the sign is kept by the numerator and the denominator is positive.
+// Sums and differences are not reduced. Products and quotients of reduced fractions cancel crosswise, with the gcds
+// of the smaller operands, and stay reduced. The common factor is removed when the value is compared, printed or
+// asked for its parts, and when the fraction has grown to twice the limbs it had after its last reduction.
+// Reduction changes the members of a const fraction, so one shared between threads has to be reduced first.
+struct big_rational {
+  // reduction is not forced on fractions shorter than this
+  static constexpr size_t REDUCE_MIN_LIMBS = 8;
+
+  big_rational();
+  big_rational(int a);
+  big_rational(big_integer const& a);
+  big_rational(big_integer const& num, big_integer const& den);
+  // "p" or "p/q"
+  explicit big_rational(std::string const& str);
+
+  big_integer const& numerator() const;
+  big_integer const& denominator() const;
+
+  // removes the common factor now instead of when it is needed
+  void reduce() const;
+  bool is_reduced() const;
+
+  big_rational& operator+=(big_rational const& a);
+  big_rational& operator-=(big_rational const& a);
+  big_rational& operator*=(big_rational const& a);
+  big_rational& operator/=(big_rational const& a);
+
+  big_rational operator+() const;
+  big_rational operator-() const;
+
+  friend big_rational operator+(big_rational a, big_rational const& b) {
+    return a += b;
+  }
+
+  friend big_rational operator-(big_rational a, big_rational const& b) {
+    return a -= b;
+  }
+
+  friend big_rational operator*(big_rational a, big_rational const& b) {
+    return a *= b;
+  }
+
+  friend big_rational operator/(big_rational a, big_rational const& b) {
+    return a /= b;
+  }
+
+  friend bool operator==(big_rational const& a, big_rational const& b) {
+    return a.equals(b);
+  }
+
+  friend bool operator!=(big_rational const& a, big_rational const& b) {
+    return !a.equals(b);
+  }
+
+  friend bool operator<(big_rational const& a, big_rational const& b) {
+    return a.compare(b) < 0;
+  }
+
+  friend bool operator>(big_rational const& a, big_rational const& b) {
+    return a.compare(b) > 0;
+  }
+
+  friend bool operator<=(big_rational const& a, big_rational const& b) {
+    return a.compare(b) <= 0;
+  }
+
+  friend bool operator>=(big_rational const& a, big_rational const& b) {
+    return a.compare(b) >= 0;
+  }
+
+  friend std::string to_string(big_rational const& a);
+
+  friend std::ostream& operator<<(std::ostream& s, big_rational const& a) {
+    return s << to_string(a);
+  }
+
+ private:
+  mutable big_integer num;
+  mutable big_integer den;
+  mutable bool reduced;
+  // limbs of both parts after the last reduction
+  mutable size_t reduced_limbs;
+
+  size_t limbs() const;
+  void set_reduced(bool value);
+  void reduce_if_grown();
+  bool equals(big_rational const& b) const;
+  int32_t compare(big_rational const& b) const;
+  void add_signed(big_rational const& b, bool negate);
+};
+
+#endif //BIGINT__BIG_RATIONAL_H_
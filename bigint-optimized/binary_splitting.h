@@ -0,0 +1,151 @@
+#ifndef BIGINT__BINARY_SPLITTING_H_
+#define BIGINT__BINARY_SPLITTING_H_
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// Sums of hypergeometric series  sum a(n) * p(0) * ... * p(n) / (q(0) * ... * q(n))  by binary splitting, for any
+// number type with the big_integer operators, isqrt and pow: big_integer, big_integer_gmp.
+// A series is a type with p(n), q(n) and a(n) returning numbers. The terms are multiplied together in a balanced
+// tree, so the work goes into few multiplications of operands of equal size, and one division at the end.
+
+// extra digits computed and dropped by the digit functions
+#ifndef BIGINT_SERIES_GUARD_DIGITS
+#define BIGINT_SERIES_GUARD_DIGITS 10
+#endif
+
+template<typename Number>
+struct split_sums {
+  Number p;
+  Number q;
+  Number t;
+};
+
+// P = p(lo) * ... * p(hi - 1), Q = q(lo) * ... * q(hi - 1) and T / Q = the sum over [lo, hi) as if the series
+// started at lo; P of the last range of a sum is never used and stays unset without need_p
+template<typename Number, typename Series>
+split_sums<Number> binary_split(Series const& series, uint64_t lo, uint64_t hi, bool need_p = true) {
+  split_sums<Number> res;
+  if (hi - lo == 1) {
+    res.p = series.p(lo);
+    res.q = series.q(lo);
+    res.t = series.a(lo) * res.p;
+    return res;
+  }
+
+  uint64_t mid = lo + (hi - lo) / 2;
+  split_sums<Number> left = binary_split<Number>(series, lo, mid, true);
+  split_sums<Number> right = binary_split<Number>(series, mid, hi, need_p);
+  res.t = left.t * right.q + left.p * right.t;
+  res.q = left.q * right.q;
+  if (need_p) {
+    res.p = left.p * right.p;
+  }
+  return res;
+}
+
+// e = sum 1 / n!
+template<typename Number>
+struct e_series {
+  Number p(uint64_t) const {
+    return 1;
+  }
+
+  Number q(uint64_t n) const {
+    return n == 0 ? 1 : static_cast<int>(n);
+  }
+
+  Number a(uint64_t) const {
+    return 1;
+  }
+};
+
+// ln 2 = 3/4 * sum (-1)^n * n!^2 / (2^n * (2n + 1)!)
+template<typename Number>
+struct ln2_series {
+  Number p(uint64_t n) const {
+    return n == 0 ? 1 : -static_cast<int>(n);
+  }
+
+  Number q(uint64_t n) const {
+    return n == 0 ? 1 : static_cast<int>(8 * n + 4);
+  }
+
+  Number a(uint64_t) const {
+    return 1;
+  }
+};
+
+// Chudnovsky: 1 / pi = 12 / 640320^(3/2) * sum (-1)^k * (6k)! * (13591409 + 545140134k) / ((3k)! * k!^3 * 640320^3k)
+template<typename Number>
+struct chudnovsky_series {
+  Number p(uint64_t k) const {
+    if (k == 0) {
+      return 1;
+    }
+    int n = static_cast<int>(k);
+    return Number(-(6 * n - 5)) * Number(2 * n - 1) * Number(6 * n - 1);
+  }
+
+  Number q(uint64_t k) const {
+    if (k == 0) {
+      return 1;
+    }
+    Number n = static_cast<int>(k);
+    return n * n * n * c3_over_24;
+  }
+
+  Number a(uint64_t k) const {
+    return Number(545140134) * Number(static_cast<int>(k)) + Number(13591409);
+  }
+
+  // 640320^3 / 24
+  Number c3_over_24 = Number(640320) * Number(640320) * Number(640320 / 24);
+};
+
+// "i.ddd" with digits decimals of scaled / 10^(digits + BIGINT_SERIES_GUARD_DIGITS), truncated
+template<typename Number>
+std::string series_decimals(Number const& scaled, size_t digits) {
+  std::string s = to_string(scaled);
+  s.resize(s.size() - BIGINT_SERIES_GUARD_DIGITS);
+  if (s.size() <= digits) {
+    s.insert(0, digits + 1 - s.size(), '0');
+  }
+  return digits == 0 ? s : s.insert(s.size() - digits, 1, '.');
+}
+
+// every digit function returns the value truncated to digits decimals, the last ones are only as good as the guard
+template<typename Number>
+std::string pi_digits(size_t digits) {
+  size_t n = digits + BIGINT_SERIES_GUARD_DIGITS;
+  // 14.18 digits per term
+  uint64_t terms = n / 14 + 2;
+  split_sums<Number> s = binary_split<Number>(chudnovsky_series<Number>(), 0, terms, false);
+  Number one = pow(Number(10), n);
+  Number root = isqrt(Number(10005) * one * one);
+  return series_decimals(Number(426880) * root * s.q / s.t, digits);
+}
+
+template<typename Number>
+std::string e_digits(size_t digits) {
+  size_t n = digits + BIGINT_SERIES_GUARD_DIGITS;
+  // the first left out term 1 / terms! is below 10^-(n + 1)
+  uint64_t terms = 1;
+  for (double log_factorial = 0; log_factorial < static_cast<double>(n + 1); ++terms) {
+    log_factorial += std::log10(static_cast<double>(terms));
+  }
+  split_sums<Number> s = binary_split<Number>(e_series<Number>(), 0, terms, false);
+  return series_decimals(s.t * pow(Number(10), n) / s.q, digits);
+}
+
+template<typename Number>
+std::string ln2_digits(size_t digits) {
+  size_t n = digits + BIGINT_SERIES_GUARD_DIGITS;
+  // every term is 3 bits smaller than the one before
+  uint64_t terms = n * 10 / 9 + 2;
+  split_sums<Number> s = binary_split<Number>(ln2_series<Number>(), 0, terms, false);
+  return series_decimals(Number(3) * s.t * pow(Number(10), n) / (Number(4) * s.q), digits);
+}
+
+#endif //BIGINT__BINARY_SPLITTING_H_
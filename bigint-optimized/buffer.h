@@ -5,14 +5,23 @@
 #ifndef BIGINT__BUFFER_H_
 #define BIGINT__BUFFER_H_
 
+#include <stdexcept>
+#include <string>
+#include "limb_span.h"
 #include "shared_container.h"
 
+// limbs stored inside the object before it goes to the heap, set at build time.
+// The size and the small flag share one word, so 4 limbs take no more space than the pointer next to them did with 2
+// (a number is limited to 2^32 - 1 limbs).
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
+
 struct buffer {
-  static constexpr size_t MAX_SMALL = 2;
+  static constexpr size_t MAX_SMALL = BIGINT_INLINE_LIMBS;
+  static_assert(MAX_SMALL > 0, "at least one limb has to fit inline");
 
-  explicit buffer(uint32_t a) : size(1), small(true) {
-    small_data[0] = a;
-  }
+  explicit buffer(uint32_t a) : size(1), small(true), small_data{a} {}
 
   buffer(buffer const& a) : size(a.size), small(a.small) {
     if (small) {
@@ -23,6 +32,15 @@ struct buffer {
     }
   }
 
+  buffer(buffer&& a) noexcept : size(a.size), small(a.small) {
+    if (small) {
+      std::copy(a.small_data, a.small_data + a.size, small_data);
+    } else {
+      shared_data = a.shared_data;
+      a.reset();
+    }
+  }
+
   ~buffer() {
     if (!small) {
       shared_data->delete_instance();
@@ -42,6 +60,25 @@ struct buffer {
     return small ? small_data[i] : (*shared_data)[i];
   }
 
+  // ownership is checked once, the span stays valid until the size or the capacity changes;
+  // the cached digits are dropped here, writes through a span kept across to_string would leave them stale
+  limb_span span() {
+    if (small) {
+      return {small_data, size};
+    }
+    unshare();
+    return {shared_data->data(), size};
+  }
+
+  const_limb_span span() const {
+    return {small ? small_data : shared_data->data(), size};
+  }
+
+  // never unshares, even when called on a mutable buffer
+  const_limb_span cspan() const {
+    return span();
+  }
+
   uint32_t const& back() const {
     return small ? small_data[size - 1] : shared_data->back();
   }
@@ -50,8 +87,39 @@ struct buffer {
     return size;
   }
 
+  size_t capacity() const {
+    return small ? MAX_SMALL : shared_data->capacity();
+  }
+
+  // numbers on the heap render their digits once for all the copies sharing them
+  template<typename F>
+  std::string decimal(F render) const {
+    return small ? render() : shared_data->decimal(render);
+  }
+
   buffer& operator=(buffer const& a) {
-    if (*this == a) {
+    if (this == &a) {
+      return *this;
+    }
+
+    // taken before releasing our own storage, which may be the same container
+    if (!a.small) {
+      a.shared_data->increase_ref();
+    }
+    this->~buffer();
+    size = a.size;
+    small = a.small;
+    if (a.small) {
+      std::copy(a.small_data, a.small_data + a.size, small_data);
+    } else {
+      shared_data = a.shared_data;
+    }
+
+    return *this;
+  }
+
+  buffer& operator=(buffer&& a) noexcept {
+    if (this == &a) {
       return *this;
     }
 
@@ -61,7 +129,8 @@ struct buffer {
     if (a.small) {
       std::copy(a.small_data, a.small_data + a.size, small_data);
     } else {
-      shared_data = new shared_container(*a.shared_data);
+      shared_data = a.shared_data;
+      a.reset();
     }
 
     return *this;
@@ -83,16 +152,13 @@ struct buffer {
   void push_back(uint32_t a) {
     if (small) {
       if (size == MAX_SMALL) {
-        small = false;
-
-        std::vector<uint32_t> tmp(small_data, small_data + size);
-        tmp.push_back(a);
-        shared_data = new shared_container(tmp);
+        to_shared(size + 1);
+        shared_data->push_back(a);
       } else {
         small_data[size] = a;
       }
     } else {
-      unshare();
+      unshare(size + 1);
       shared_data->push_back(a);
     }
     size++;
@@ -106,21 +172,113 @@ struct buffer {
     size--;
   }
 
-  void reverse() {
+  // new limbs have unspecified values
+  void resize(size_t n) {
+    check_size(n);
+    if (small && n > MAX_SMALL) {
+      to_shared(n);
+    }
+    if (!small) {
+      unshare(n);
+      shared_data->resize(n);
+    }
+    size = n;
+  }
+
+  // new limbs are set to fill
+  void resize(size_t n, uint32_t fill) {
+    check_size(n);
+    if (small && n > MAX_SMALL) {
+      to_shared(n);
+    }
     if (small) {
-      std::reverse(small_data, small_data + size);
+      if (n > size) {
+        std::fill(small_data + size, small_data + n, fill);
+      }
     } else {
-      unshare();
-      shared_data->reverse();
+      unshare(n);
+      shared_data->resize(n, fill);
     }
+    size = n;
+  }
+
+  void reserve(size_t n) {
+    check_size(n);
+    if (small) {
+      if (n > MAX_SMALL) {
+        to_shared(n);
+      }
+    } else {
+      unshare(n);
+    }
+  }
+
+  // removes the k < size lowest limbs, O(1) for owned heap storage
+  void drop_front(size_t k) {
+    if (small) {
+      std::copy(small_data + k, small_data + size, small_data);
+    } else if (shared_data->unique()) {
+      shared_data->drop_front(k);
+    } else {
+      shared_container* tmp = shared_container::create(shared_data->data() + k, shared_data->data() + size, size - k);
+      shared_data->delete_instance();
+      shared_data = tmp;
+    }
+    size -= k;
+  }
+
+  // k zero limbs below the lowest one, O(k) when an earlier drop_front left room for them
+  void insert_front(size_t k) {
+    check_size(size + k);
+    if (small && size + k <= MAX_SMALL) {
+      std::copy_backward(small_data, small_data + size, small_data + size + k);
+      std::fill(small_data, small_data + k, 0);
+    } else if (!small && shared_data->unique() && shared_data->front_room() >= k) {
+      shared_data->insert_front(k);
+    } else {
+      shared_container* tmp = shared_container::create(size + k);
+      tmp->resize(size + k);
+      std::fill(tmp->data(), tmp->data() + k, 0);
+      const_limb_span x = cspan();
+      std::copy(x.data, x.data + x.size, tmp->data() + k);
+      if (!small) {
+        shared_data->delete_instance();
+      }
+      small = false;
+      shared_data = tmp;
+    }
+    size += k;
   }
 
   void unshare() {
     shared_data = shared_data->make_unique();
   }
 
+  // own storage with room for at least capacity limbs
+  void unshare(size_t capacity) {
+    shared_data = shared_data->make_unique(capacity);
+  }
+
  private:
-  size_t size;
+  static void check_size(size_t n) {
+    if (n > UINT32_MAX) {
+      throw std::length_error("big_integer is too long");
+    }
+  }
+
+  void reset() {
+    size = 1;
+    small = true;
+    small_data[0] = 0;
+  }
+
+  void to_shared(size_t capacity) {
+    shared_container* tmp = shared_container::create(small_data, small_data + size, capacity);
+    small = false;
+    shared_data = tmp;
+  }
+
+  uint32_t size;
   bool small;
   union {
     uint32_t small_data[MAX_SMALL];
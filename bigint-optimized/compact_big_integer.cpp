@@ -0,0 +1,64 @@
+#include "compact_big_integer.h"
+
+uintptr_t compact_big_integer::from_big(big_integer const& a) {
+  const_limb_span x = a.value.cspan();
+  if (x.size <= 2) {
+    uint64_t magnitude = x.data[0] | (x.size == 2 ? static_cast<uint64_t>(x.data[1]) << 32 : 0);
+    if (magnitude <= static_cast<uint64_t>(INLINE_MAX) || (a.sign && magnitude == uint64_t(1) << 61)) {
+      return encode(a.sign ? static_cast<int64_t>(-magnitude) : static_cast<int64_t>(magnitude));
+    }
+  }
+
+  header* h = new(limb_pool::allocate(block_bytes(x.size))) header();
+  h->size = static_cast<uint32_t>(x.size);
+  h->sign = a.sign;
+  std::copy(x.data, x.data + x.size, h->limbs());
+  return reinterpret_cast<uintptr_t>(h);
+}
+
+big_integer compact_big_integer::to_big_integer() const {
+  if (is_inline()) {
+    int64_t a = decode(word);
+    big_integer res = big_integer::from_uint64(a < 0 ? -static_cast<uint64_t>(a) : a);
+    res.sign = a < 0;
+    return res;
+  }
+
+  header* h = to_header();
+  big_integer res(static_cast<size_t>(h->size));
+  limb_span x = res.value.span();
+  std::copy(h->limbs(), h->limbs() + h->size, x.data);
+  res.sign = h->sign;
+  return res;
+}
+
+int32_t compact_big_integer::compare(compact_big_integer const& a, compact_big_integer const& b) {
+  if (a.is_inline() && b.is_inline()) {
+    int64_t x = decode(a.word), y = decode(b.word);
+    return x < y ? -1 : x > y;
+  }
+  // a heap value is beyond the inline range on the side of its sign
+  if (a.is_inline()) {
+    return b.to_header()->sign ? 1 : -1;
+  }
+  if (b.is_inline()) {
+    return a.to_header()->sign ? -1 : 1;
+  }
+
+  header* x = a.to_header();
+  header* y = b.to_header();
+  if (x->sign != y->sign) {
+    return x->sign ? -1 : 1;
+  }
+  int32_t res = 0;
+  if (x->size != y->size) {
+    res = x->size < y->size ? -1 : 1;
+  } else {
+    for (size_t i = x->size; i > 0 && res == 0; i--) {
+      if (x->limbs()[i - 1] != y->limbs()[i - 1]) {
+        res = x->limbs()[i - 1] < y->limbs()[i - 1] ? -1 : 1;
+      }
+    }
+  }
+  return x->sign ? -res : res;
+}
@@ -0,0 +1,230 @@
+#ifndef BIGINT__COMPACT_BIG_INTEGER_H_
+#define BIGINT__COMPACT_BIG_INTEGER_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "big_integer.h"
+
+// One word per number, for keeping many of them in containers. A word with the low bit set holds a signed value
+// of 62 bits above its two tag bits, any other word points to an immutable header with the sign, the size and
+// the limbs, shared between copies. A value is kept inline whenever it fits, so equal numbers have equal
+// representations. Anything the inline values can't do directly is computed by big_integer.
+struct compact_big_integer {
+  static constexpr int64_t INLINE_MAX = (int64_t(1) << 61) - 1;
+  static constexpr int64_t INLINE_MIN = -(int64_t(1) << 61);
+
+  compact_big_integer() : word(encode(0)) {}
+
+  compact_big_integer(int64_t a) {
+    if (a >= INLINE_MIN && a <= INLINE_MAX) {
+      word = encode(a);
+    } else {
+      big_integer b = big_integer::from_uint64(a < 0 ? -static_cast<uint64_t>(a) : a);
+      b.sign = a < 0;
+      word = from_big(b);
+    }
+  }
+
+  explicit compact_big_integer(big_integer const& a) : word(from_big(a)) {}
+
+  explicit compact_big_integer(std::string const& str) : compact_big_integer(big_integer(str)) {}
+
+  compact_big_integer(compact_big_integer const& a) : word(a.word) {
+    if (!is_inline()) {
+      to_header()->refs.increase();
+    }
+  }
+
+  compact_big_integer(compact_big_integer&& a) noexcept : word(a.word) {
+    a.word = encode(0);
+  }
+
+  ~compact_big_integer() {
+    release();
+  }
+
+  compact_big_integer& operator=(compact_big_integer const& a) {
+    if (!a.is_inline()) {
+      a.to_header()->refs.increase();
+    }
+    release();
+    word = a.word;
+    return *this;
+  }
+
+  compact_big_integer& operator=(compact_big_integer&& a) noexcept {
+    if (this != &a) {
+      release();
+      word = a.word;
+      a.word = encode(0);
+    }
+    return *this;
+  }
+
+  big_integer to_big_integer() const;
+
+  bool is_inline() const {
+    return (word & INLINE_TAG) != 0;
+  }
+
+  // bytes of the heap block, 0 for an inline value
+  size_t heap_bytes() const {
+    return is_inline() ? 0 : limb_pool::good_size(block_bytes(to_header()->size));
+  }
+
+  compact_big_integer& operator+=(compact_big_integer const& b) {
+    if (is_inline() && b.is_inline()) {
+      // 62-bit operands can't overflow 64 bits
+      return *this = compact_big_integer(decode(word) + decode(b.word));
+    }
+    return *this = compact_big_integer(to_big_integer() + b.to_big_integer());
+  }
+
+  compact_big_integer& operator-=(compact_big_integer const& b) {
+    if (is_inline() && b.is_inline()) {
+      return *this = compact_big_integer(decode(word) - decode(b.word));
+    }
+    return *this = compact_big_integer(to_big_integer() - b.to_big_integer());
+  }
+
+  compact_big_integer& operator*=(compact_big_integer const& b) {
+    if (is_inline() && b.is_inline()) {
+      int64_t x = decode(word), y = decode(b.word);
+      uint64_t mx = x < 0 ? -static_cast<uint64_t>(x) : x;
+      uint64_t my = y < 0 ? -static_cast<uint64_t>(y) : y;
+      if (mx == 0 || my <= static_cast<uint64_t>(INLINE_MAX) / mx) {
+        word = encode(x * y);
+        return *this;
+      }
+    }
+    return *this = compact_big_integer(to_big_integer() * b.to_big_integer());
+  }
+
+  compact_big_integer& operator/=(compact_big_integer const& b) {
+    if (is_inline() && b.is_inline() && b.word != encode(0)) {
+      // the quotient only shrinks, except INLINE_MIN / -1
+      return *this = compact_big_integer(decode(word) / decode(b.word));
+    }
+    return *this = compact_big_integer(to_big_integer() / b.to_big_integer());
+  }
+
+  compact_big_integer& operator%=(compact_big_integer const& b) {
+    if (is_inline() && b.is_inline() && b.word != encode(0)) {
+      word = encode(decode(word) % decode(b.word));
+      return *this;
+    }
+    return *this = compact_big_integer(to_big_integer() % b.to_big_integer());
+  }
+
+  compact_big_integer operator-() const {
+    if (is_inline()) {
+      return compact_big_integer(-decode(word));
+    }
+    return compact_big_integer(-to_big_integer());
+  }
+
+  friend compact_big_integer operator+(compact_big_integer a, compact_big_integer const& b) {
+    return a += b;
+  }
+
+  friend compact_big_integer operator-(compact_big_integer a, compact_big_integer const& b) {
+    return a -= b;
+  }
+
+  friend compact_big_integer operator*(compact_big_integer a, compact_big_integer const& b) {
+    return a *= b;
+  }
+
+  friend compact_big_integer operator/(compact_big_integer a, compact_big_integer const& b) {
+    return a /= b;
+  }
+
+  friend compact_big_integer operator%(compact_big_integer a, compact_big_integer const& b) {
+    return a %= b;
+  }
+
+  friend bool operator==(compact_big_integer const& a, compact_big_integer const& b) {
+    return a.word == b.word || (!a.is_inline() && !b.is_inline() && compare(a, b) == 0);
+  }
+
+  friend bool operator!=(compact_big_integer const& a, compact_big_integer const& b) {
+    return !(a == b);
+  }
+
+  friend bool operator<(compact_big_integer const& a, compact_big_integer const& b) {
+    return compare(a, b) < 0;
+  }
+
+  friend bool operator>(compact_big_integer const& a, compact_big_integer const& b) {
+    return compare(a, b) > 0;
+  }
+
+  friend bool operator<=(compact_big_integer const& a, compact_big_integer const& b) {
+    return compare(a, b) <= 0;
+  }
+
+  friend bool operator>=(compact_big_integer const& a, compact_big_integer const& b) {
+    return compare(a, b) >= 0;
+  }
+
+  friend std::string to_string(compact_big_integer const& a) {
+    return a.is_inline() ? std::to_string(decode(a.word)) : to_string(a.to_big_integer());
+  }
+
+  friend std::ostream& operator<<(std::ostream& s, compact_big_integer const& a) {
+    return s << to_string(a);
+  }
+
+ private:
+  static constexpr uintptr_t INLINE_TAG = 1;
+  static constexpr int TAG_BITS = 2;
+
+  // limbs follow in the same block, they are never changed after construction
+  struct header {
+    ref_count refs;
+    uint32_t size;
+    bool sign;
+
+    uint32_t* limbs() {
+      return reinterpret_cast<uint32_t*>(this + 1);
+    }
+  };
+
+  static_assert(alignof(header) >= 4, "the two tag bits have to be free in a header pointer");
+
+  static uintptr_t encode(int64_t a) {
+    return static_cast<uintptr_t>(static_cast<uint64_t>(a) << TAG_BITS) | INLINE_TAG;
+  }
+
+  static int64_t decode(uintptr_t word) {
+    uint64_t bits = static_cast<uint64_t>(word) >> TAG_BITS;
+    // sign extension of the 62-bit value
+    return static_cast<int64_t>(bits ^ (uint64_t(1) << 61)) - (int64_t(1) << 61);
+  }
+
+  static size_t block_bytes(size_t size) {
+    return sizeof(header) + size * sizeof(uint32_t);
+  }
+
+  header* to_header() const {
+    return reinterpret_cast<header*>(word);
+  }
+
+  void release() {
+    if (!is_inline() && to_header()->refs.release()) {
+      size_t bytes = block_bytes(to_header()->size);
+      to_header()->~header();
+      limb_pool::deallocate(to_header(), bytes);
+    }
+  }
+
+  static uintptr_t from_big(big_integer const& a);
+  static int32_t compare(compact_big_integer const& a, compact_big_integer const& b);
+
+  uintptr_t word;
+};
+
+static_assert(sizeof(compact_big_integer) == 8, "62-bit inline values need 64-bit words");
+
+#endif //BIGINT__COMPACT_BIG_INTEGER_H_
@@ -0,0 +1,73 @@
+#ifndef BIGINT__CONSTANT_POOL_H_
+#define BIGINT__CONSTANT_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// entries of the tables of 10^(2^k) and 2^(2^k), set at build time
+#ifndef BIGINT_CONSTANT_POWERS
+#define BIGINT_CONSTANT_POWERS 24
+#endif
+
+// Process-wide immutable numbers, handed out by reference, so reading them costs nothing and copying them shares
+// their limbs. Small integers are made together on first use, every power when it is first asked for, by squaring
+// the previous one. The powers are never freed, so references to them stay valid until the process exits.
+// With a plain reference count copies of a constant must not be made on different threads.
+template<typename Number>
+struct constant_pool {
+  static constexpr int SMALL_MIN = -128;
+  static constexpr int SMALL_MAX = 1024;
+  static constexpr size_t POWERS = BIGINT_CONSTANT_POWERS;
+  static_assert(POWERS > 0, "the power tables start with the base itself");
+
+  // SMALL_MIN <= n <= SMALL_MAX
+  static Number const& small(int n) {
+    static small_table const table;
+    return table.values[static_cast<size_t>(n - SMALL_MIN)];
+  }
+
+  // 10^(2^k), k < POWERS
+  static Number const& power_of_ten(size_t k) {
+    static std::atomic<Number const*> table[POWERS];
+    return power(table, k, 10);
+  }
+
+  // 2^(2^k), k < POWERS
+  static Number const& power_of_two(size_t k) {
+    static std::atomic<Number const*> table[POWERS];
+    return power(table, k, 2);
+  }
+
+ private:
+  struct small_table {
+    small_table() {
+      values.reserve(SMALL_MAX - SMALL_MIN + 1);
+      for (int n = SMALL_MIN; n <= SMALL_MAX; ++n) {
+        values.emplace_back(n);
+      }
+    }
+
+    std::vector<Number> values;
+  };
+
+  // threads asking for the same missing power may both compute it, only one of them is kept
+  static Number const& power(std::atomic<Number const*>* table, size_t k, int base) {
+    Number const* res = table[k].load(std::memory_order_acquire);
+    if (res == nullptr) {
+      Number* fresh = new Number(base);
+      if (k != 0) {
+        Number const& root = power(table, k - 1, base);
+        *fresh = root * root;
+      }
+      if (table[k].compare_exchange_strong(res, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        res = fresh;
+      } else {
+        delete fresh;
+      }
+    }
+    return *res;
+  }
+};
+
+#endif //BIGINT__CONSTANT_POOL_H_
@@ -0,0 +1,390 @@
+#ifndef BIGINT__FIXED_INT_H_
+#define BIGINT__FIXED_INT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include "big_integer.h"
+
+// limb kernels unrolled by recursion on the limb index I < N, the specialization below ends it
+template<size_t I, size_t N, bool = (I < N)>
+struct fixed_unroll {
+  // r = a + b + carry, returns the carry out of the top limb
+  static constexpr uint32_t add(uint32_t* r, uint32_t const* a, uint32_t const* b, uint32_t carry) {
+    uint64_t sum = uint64_t(a[I]) + b[I] + carry;
+    r[I] = static_cast<uint32_t>(sum);
+    return fixed_unroll<I + 1, N>::add(r, a, b, static_cast<uint32_t>(sum >> 32));
+  }
+
+  // r = a - b - borrow, returns the borrow out of the top limb
+  static constexpr uint32_t sub(uint32_t* r, uint32_t const* a, uint32_t const* b, uint32_t borrow) {
+    uint64_t diff = uint64_t(a[I]) - b[I] - borrow;
+    r[I] = static_cast<uint32_t>(diff);
+    return fixed_unroll<I + 1, N>::sub(r, a, b, static_cast<uint32_t>(diff >> 63));
+  }
+
+  template<typename Op>
+  static constexpr void bitwise(uint32_t* r, uint32_t const* a, uint32_t const* b, Op op) {
+    r[I] = op(a[I], b[I]);
+    fixed_unroll<I + 1, N>::bitwise(r, a, b, op);
+  }
+
+  // the higher limbs decide first
+  static constexpr int32_t compare(uint32_t const* a, uint32_t const* b) {
+    int32_t higher = fixed_unroll<I + 1, N>::compare(a, b);
+    return higher != 0 ? higher : a[I] < b[I] ? -1 : a[I] > b[I];
+  }
+
+  // r[I + J] += a[I] * b[J] for all I + J < N, the product wraps around
+  template<size_t J = 0, bool = (I + J < N)>
+  struct row {
+    static constexpr void mul(uint32_t* r, uint32_t const* a, uint32_t const* b, uint32_t carry) {
+      uint64_t t = uint64_t(a[I]) * b[J] + r[I + J] + carry;
+      r[I + J] = static_cast<uint32_t>(t);
+      row<J + 1>::mul(r, a, b, static_cast<uint32_t>(t >> 32));
+    }
+  };
+
+  template<size_t J>
+  struct row<J, false> {
+    static constexpr void mul(uint32_t*, uint32_t const*, uint32_t const*, uint32_t) {}
+  };
+
+  static constexpr void mul(uint32_t* r, uint32_t const* a, uint32_t const* b) {
+    row<>::mul(r, a, b, 0);
+    fixed_unroll<I + 1, N>::mul(r, a, b);
+  }
+};
+
+template<size_t I, size_t N>
+struct fixed_unroll<I, N, false> {
+  static constexpr uint32_t add(uint32_t*, uint32_t const*, uint32_t const*, uint32_t carry) {
+    return carry;
+  }
+
+  static constexpr uint32_t sub(uint32_t*, uint32_t const*, uint32_t const*, uint32_t borrow) {
+    return borrow;
+  }
+
+  template<typename Op>
+  static constexpr void bitwise(uint32_t*, uint32_t const*, uint32_t const*, Op) {}
+
+  static constexpr int32_t compare(uint32_t const*, uint32_t const*) {
+    return 0;
+  }
+
+  static constexpr void mul(uint32_t*, uint32_t const*, uint32_t const*) {}
+};
+
+// Integer of exactly Bits bits in a limb array, two's complement, every operation wraps around modulo 2^Bits.
+// Signed only changes how the top bit is read: comparison, division, right shift and conversion to big_integer.
+// Division truncates and >> rounds towards minus infinity, like big_integer. Everything except the conversions
+// and to_string is constexpr.
+template<size_t Bits, bool Signed = true>
+struct fixed_int {
+  static_assert(Bits > 0 && Bits % 32 == 0, "fixed_int is a whole number of 32-bit limbs");
+  static constexpr size_t LIMBS = Bits / 32;
+
+  constexpr fixed_int() : limbs{} {}
+
+  // sign-extended for signed and unsigned types alike, so -1 is all ones
+  constexpr fixed_int(int64_t a) : limbs{} {
+    uint64_t x = static_cast<uint64_t>(a);
+    limbs[0] = static_cast<uint32_t>(x);
+    for (size_t i = 1; i != LIMBS; ++i) {
+      limbs[i] = i == 1 ? static_cast<uint32_t>(x >> 32) : a < 0 ? UINT32_MAX : 0;
+    }
+  }
+
+  // a modulo 2^Bits, lossless whenever a fits
+  explicit fixed_int(big_integer const& a) : limbs{} {
+    const_limb_span x = a.value.cspan();
+    for (size_t i = 0; i != LIMBS && i != x.size; ++i) {
+      limbs[i] = x.data[i];
+    }
+    if (a.sign) {
+      *this = -*this;
+    }
+  }
+
+  explicit fixed_int(std::string const& str) : fixed_int(big_integer(str)) {}
+
+  big_integer to_big_integer() const {
+    bool negative = is_negative();
+    // the magnitude of the minimum is still right when read as unsigned
+    fixed_int magnitude = negative ? -*this : *this;
+    big_integer res(LIMBS);
+    limb_span x = res.value.span();
+    std::copy(magnitude.limbs, magnitude.limbs + LIMBS, x.data);
+    res.sign = negative;
+    res.normalize();
+    return res;
+  }
+
+  constexpr bool is_negative() const {
+    return Signed && (limbs[LIMBS - 1] >> 31) != 0;
+  }
+
+  constexpr uint32_t limb(size_t i) const {
+    return limbs[i];
+  }
+
+  constexpr fixed_int& operator+=(fixed_int const& b) {
+    fixed_unroll<0, LIMBS>::add(limbs, limbs, b.limbs, 0);
+    return *this;
+  }
+
+  constexpr fixed_int& operator-=(fixed_int const& b) {
+    fixed_unroll<0, LIMBS>::sub(limbs, limbs, b.limbs, 0);
+    return *this;
+  }
+
+  constexpr fixed_int& operator*=(fixed_int const& b) {
+    fixed_int res;
+    fixed_unroll<0, LIMBS>::mul(res.limbs, limbs, b.limbs);
+    return *this = res;
+  }
+
+  constexpr fixed_int& operator/=(fixed_int const& b) {
+    fixed_int r;
+    div_mod(*this, b, *this, r);
+    return *this;
+  }
+
+  constexpr fixed_int& operator%=(fixed_int const& b) {
+    fixed_int q;
+    div_mod(*this, b, q, *this);
+    return *this;
+  }
+
+  constexpr fixed_int& operator&=(fixed_int const& b) {
+    fixed_unroll<0, LIMBS>::bitwise(limbs, limbs, b.limbs, std::bit_and<uint32_t>());
+    return *this;
+  }
+
+  constexpr fixed_int& operator|=(fixed_int const& b) {
+    fixed_unroll<0, LIMBS>::bitwise(limbs, limbs, b.limbs, std::bit_or<uint32_t>());
+    return *this;
+  }
+
+  constexpr fixed_int& operator^=(fixed_int const& b) {
+    fixed_unroll<0, LIMBS>::bitwise(limbs, limbs, b.limbs, std::bit_xor<uint32_t>());
+    return *this;
+  }
+
+  // a negative count shifts the other way, as for big_integer
+  constexpr fixed_int& operator<<=(int b) {
+    return b < 0 ? shift_right(0 - static_cast<size_t>(b)) : shift_left(static_cast<size_t>(b));
+  }
+
+  // shifts by Bits or more leave only the sign
+  constexpr fixed_int& operator>>=(int b) {
+    return b < 0 ? shift_left(0 - static_cast<size_t>(b)) : shift_right(static_cast<size_t>(b));
+  }
+
+  constexpr fixed_int operator+() const {
+    return *this;
+  }
+
+  constexpr fixed_int operator-() const {
+    fixed_int res;
+    fixed_unroll<0, LIMBS>::sub(res.limbs, res.limbs, limbs, 0);
+    return res;
+  }
+
+  constexpr fixed_int operator~() const {
+    fixed_int res(-1);
+    return res ^= *this;
+  }
+
+  constexpr fixed_int& operator++() {
+    return *this += 1;
+  }
+
+  constexpr fixed_int operator++(int) {
+    fixed_int res = *this;
+    *this += 1;
+    return res;
+  }
+
+  constexpr fixed_int& operator--() {
+    return *this -= 1;
+  }
+
+  constexpr fixed_int operator--(int) {
+    fixed_int res = *this;
+    *this -= 1;
+    return res;
+  }
+
+  friend constexpr fixed_int operator+(fixed_int a, fixed_int const& b) {
+    return a += b;
+  }
+
+  friend constexpr fixed_int operator-(fixed_int a, fixed_int const& b) {
+    return a -= b;
+  }
+
+  friend constexpr fixed_int operator*(fixed_int a, fixed_int const& b) {
+    return a *= b;
+  }
+
+  friend constexpr fixed_int operator/(fixed_int a, fixed_int const& b) {
+    return a /= b;
+  }
+
+  friend constexpr fixed_int operator%(fixed_int a, fixed_int const& b) {
+    return a %= b;
+  }
+
+  friend constexpr fixed_int operator&(fixed_int a, fixed_int const& b) {
+    return a &= b;
+  }
+
+  friend constexpr fixed_int operator|(fixed_int a, fixed_int const& b) {
+    return a |= b;
+  }
+
+  friend constexpr fixed_int operator^(fixed_int a, fixed_int const& b) {
+    return a ^= b;
+  }
+
+  friend constexpr fixed_int operator<<(fixed_int a, int b) {
+    return a <<= b;
+  }
+
+  friend constexpr fixed_int operator>>(fixed_int a, int b) {
+    return a >>= b;
+  }
+
+  friend constexpr bool operator==(fixed_int const& a, fixed_int const& b) {
+    return fixed_unroll<0, LIMBS>::compare(a.limbs, b.limbs) == 0;
+  }
+
+  friend constexpr bool operator!=(fixed_int const& a, fixed_int const& b) {
+    return !(a == b);
+  }
+
+  friend constexpr bool operator<(fixed_int const& a, fixed_int const& b) {
+    return compare(a, b) < 0;
+  }
+
+  friend constexpr bool operator>(fixed_int const& a, fixed_int const& b) {
+    return compare(a, b) > 0;
+  }
+
+  friend constexpr bool operator<=(fixed_int const& a, fixed_int const& b) {
+    return compare(a, b) <= 0;
+  }
+
+  friend constexpr bool operator>=(fixed_int const& a, fixed_int const& b) {
+    return compare(a, b) >= 0;
+  }
+
+  friend std::string to_string(fixed_int const& a) {
+    return to_string(a.to_big_integer());
+  }
+
+  friend std::ostream& operator<<(std::ostream& s, fixed_int const& a) {
+    return s << to_string(a);
+  }
+
+ private:
+  static constexpr int32_t compare(fixed_int const& a, fixed_int const& b) {
+    if (a.is_negative() != b.is_negative()) {
+      return a.is_negative() ? -1 : 1;
+    }
+    // two's complement keeps the order within one sign
+    return fixed_unroll<0, LIMBS>::compare(a.limbs, b.limbs);
+  }
+
+  constexpr fixed_int& shift_left(size_t b) {
+    size_t whole = b / 32, bits = b % 32;
+    for (size_t i = LIMBS; i > 0; i--) {
+      size_t from = i - 1;
+      uint32_t hi = from >= whole ? limbs[from - whole] : 0;
+      uint32_t lo = from >= whole + 1 ? limbs[from - whole - 1] : 0;
+      limbs[from] = bits == 0 ? hi : hi << bits | lo >> (32 - bits);
+    }
+    return *this;
+  }
+
+  constexpr fixed_int& shift_right(size_t b) {
+    uint32_t fill = is_negative() ? UINT32_MAX : 0;
+    size_t whole = b / 32, bits = b % 32;
+    for (size_t i = 0; i != LIMBS; ++i) {
+      uint32_t lo = i + whole < LIMBS ? limbs[i + whole] : fill;
+      uint32_t hi = i + whole + 1 < LIMBS ? limbs[i + whole + 1] : fill;
+      limbs[i] = bits == 0 ? lo : lo >> bits | hi << (32 - bits);
+    }
+    return *this;
+  }
+
+  // truncating division of the magnitudes, the remainder takes the sign of the dividend
+  static constexpr void div_mod(fixed_int a, fixed_int b, fixed_int& q, fixed_int& r) {
+    if (b == 0) {
+      throw std::domain_error("fixed_int division by zero");
+    }
+    bool a_negative = a.is_negative(), b_negative = b.is_negative();
+    if (a_negative) {
+      a = -a;
+    }
+    if (b_negative) {
+      b = -b;
+    }
+
+    q = 0;
+    r = 0;
+    size_t top = LIMBS;
+    while (top > 1 && b.limbs[top - 1] == 0) {
+      top--;
+    }
+    if (top == 1) {
+      uint64_t rem = 0;
+      for (size_t i = LIMBS; i > 0; i--) {
+        uint64_t cur = rem << 32 | a.limbs[i - 1];
+        q.limbs[i - 1] = static_cast<uint32_t>(cur / b.limbs[0]);
+        rem = cur % b.limbs[0];
+      }
+      r.limbs[0] = static_cast<uint32_t>(rem);
+    } else {
+      // a wide divisor leaves a quotient of at most Bits - 32 bits, found bit by bit
+      for (size_t i = Bits; i > 0; i--) {
+        uint32_t carry = r.limbs[LIMBS - 1] >> 31;
+        r.shift_left_one(a.limbs[(i - 1) / 32] >> ((i - 1) % 32) & 1);
+        if (carry != 0 || fixed_unroll<0, LIMBS>::compare(r.limbs, b.limbs) >= 0) {
+          r -= b;
+          q.limbs[(i - 1) / 32] |= uint32_t(1) << ((i - 1) % 32);
+        }
+      }
+    }
+
+    if (a_negative != b_negative) {
+      q = -q;
+    }
+    if (a_negative) {
+      r = -r;
+    }
+  }
+
+  constexpr void shift_left_one(uint32_t low_bit) {
+    for (size_t i = LIMBS; i > 1; i--) {
+      limbs[i - 1] = limbs[i - 1] << 1 | limbs[i - 2] >> 31;
+    }
+    limbs[0] = limbs[0] << 1 | low_bit;
+  }
+
+  uint32_t limbs[LIMBS];
+};
+
+typedef fixed_int<128> int128;
+typedef fixed_int<256> int256;
+typedef fixed_int<512> int512;
+typedef fixed_int<128, false> uint128;
+typedef fixed_int<256, false> uint256;
+typedef fixed_int<512, false> uint512;
+
+#endif //BIGINT__FIXED_INT_H_
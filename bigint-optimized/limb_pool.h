@@ -0,0 +1,142 @@
+#ifndef BIGINT__LIMB_POOL_H_
+#define BIGINT__LIMB_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Size-class pool for limb storage. Every thread caches freed blocks in its own free lists,
+// one per power-of-two class. A block freed by another thread than the one that allocated it
+// just joins the cache of the freeing thread, so no list is ever shared between threads.
+struct limb_pool {
+  struct statistics {
+    size_t requests;
+    size_t system_allocations;
+  };
+
+  static void* allocate(size_t bytes) {
+    size_t cls = size_class(bytes);
+    cache* c = local();
+    if (c != nullptr) {
+      c->stats.requests++;
+      if (cls < CLASSES && c->lists[cls] != nullptr) {
+        node* res = c->lists[cls];
+        c->lists[cls] = res->next;
+        c->lengths[cls]--;
+        return res;
+      }
+      c->stats.system_allocations++;
+    }
+    return ::operator new(cls < CLASSES ? class_bytes(cls) : bytes);
+  }
+
+  static void deallocate(void* p, size_t bytes) {
+    size_t cls = size_class(bytes);
+    cache* c = local();
+    if (c == nullptr || cls >= CLASSES || c->lengths[cls] == MAX_CACHED) {
+      ::operator delete(p);
+      return;
+    }
+    node* n = static_cast<node*>(p);
+    n->next = c->lists[cls];
+    c->lists[cls] = n;
+    c->lengths[cls]++;
+  }
+
+  // bytes actually available in a block allocated for the given size
+  static size_t good_size(size_t bytes) {
+    size_t cls = size_class(bytes);
+    return cls < CLASSES ? class_bytes(cls) : bytes;
+  }
+
+  // counters of the calling thread
+  static statistics thread_statistics() {
+    cache* c = local();
+    return c == nullptr ? statistics{0, 0} : c->stats;
+  }
+
+ private:
+  static constexpr size_t MIN_BYTES = 16;
+  static constexpr size_t CLASSES = 13;  // 16 bytes .. 64 KiB
+  static constexpr size_t MAX_CACHED = 64;
+
+  struct node {
+    node* next;
+  };
+
+  struct cache {
+    cache() : lists(), lengths(), stats{0, 0} {}
+
+    ~cache() {
+      for (node*& head : lists) {
+        while (head != nullptr) {
+          node* next = head->next;
+          ::operator delete(head);
+          head = next;
+        }
+      }
+      alive() = false;
+    }
+
+    node* lists[CLASSES];
+    size_t lengths[CLASSES];
+    statistics stats;
+  };
+
+  static size_t class_bytes(size_t cls) {
+    return MIN_BYTES << cls;
+  }
+
+  static size_t size_class(size_t bytes) {
+    size_t cls = 0;
+    while (class_bytes(cls) < bytes) {
+      cls++;
+    }
+    return cls;
+  }
+
+  // trivially destructible, so it can still be read by destructors that run after the cache is gone
+  static bool& alive() {
+    thread_local bool value = true;
+    return value;
+  }
+
+  static cache* local() {
+    if (!alive()) {
+      return nullptr;
+    }
+    thread_local cache c;
+    return &c;
+  }
+};
+
+// allocator for standard containers drawing from the pool
+template<typename T>
+struct pool_allocator {
+  typedef T value_type;
+
+  pool_allocator() = default;
+
+  template<typename U>
+  pool_allocator(pool_allocator<U> const&) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(limb_pool::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    limb_pool::deallocate(p, n * sizeof(T));
+  }
+
+  template<typename U>
+  friend bool operator==(pool_allocator const&, pool_allocator<U> const&) {
+    return true;
+  }
+
+  template<typename U>
+  friend bool operator!=(pool_allocator const&, pool_allocator<U> const&) {
+    return false;
+  }
+};
+
+#endif //BIGINT__LIMB_POOL_H_
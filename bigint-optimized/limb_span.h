@@ -0,0 +1,18 @@
+#ifndef BIGINT__LIMB_SPAN_H_
+#define BIGINT__LIMB_SPAN_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// raw view of the limbs for arithmetic kernels
+struct limb_span {
+  uint32_t* data;
+  size_t size;
+};
+
+struct const_limb_span {
+  uint32_t const* data;
+  size_t size;
+};
+
+#endif //BIGINT__LIMB_SPAN_H_
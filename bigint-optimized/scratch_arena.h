@@ -0,0 +1,65 @@
+#ifndef BIGINT__SCRATCH_ARENA_H_
+#define BIGINT__SCRATCH_ARENA_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Per-thread bump allocator for temporary limbs of arithmetic kernels.
+// Blocks are kept after a frame is released, so once they are large enough kernels don't call malloc at all.
+struct scratch_arena {
+  // everything allocated through a frame is released when it goes out of scope
+  struct frame {
+    frame() : arena(local()), block(arena.block), used(arena.used) {}
+
+    frame(frame const&) = delete;
+    frame& operator=(frame const&) = delete;
+
+    ~frame() {
+      arena.block = block;
+      arena.used = used;
+    }
+
+    // memory is not initialized
+    uint32_t* allocate(size_t n) {
+      return arena.allocate(n);
+    }
+
+   private:
+    scratch_arena& arena;
+    size_t block;
+    size_t used;
+  };
+
+ private:
+  static constexpr size_t MIN_BLOCK = 1024;
+
+  scratch_arena() : block(0), used(0) {}
+
+  static scratch_arena& local() {
+    thread_local scratch_arena arena;
+    return arena;
+  }
+
+  uint32_t* allocate(size_t n) {
+    while (block < blocks.size() && used + n > blocks[block].size()) {
+      block++;
+      used = 0;
+    }
+    if (block == blocks.size()) {
+      size_t size = std::max(n, blocks.empty() ? MIN_BLOCK : 2 * blocks.back().size());
+      blocks.emplace_back(size);
+      used = 0;
+    }
+
+    uint32_t* res = blocks[block].data() + used;
+    used += n;
+    return res;
+  }
+
+  std::vector<std::vector<uint32_t>> blocks;
+  size_t block;
+  size_t used;
+};
+
+#endif //BIGINT__SCRATCH_ARENA_H_
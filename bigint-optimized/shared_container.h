@@ -5,67 +5,224 @@
 #ifndef BIGINT__SHARED_CONTAINER_H_
 #define BIGINT__SHARED_CONTAINER_H_
 
-#include <vector>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string>
+#include "limb_pool.h"
+
+// with atomic counts numbers sharing limbs can be copied and destroyed on different threads; the default, at the
+// price of slower single-threaded copies and releases
+#ifndef BIGINT_ATOMIC_REFCOUNT
+#define BIGINT_ATOMIC_REFCOUNT 1
+#endif
+
+#if BIGINT_ATOMIC_REFCOUNT
+struct ref_count {
+  ref_count() : value(1) {}
+
+  // only the last owner can see 1, and nobody can add a reference to a number it doesn't hold,
+  // so a unique container is provably thread-local and needs no read-modify-write
+  bool unique() const {
+    return value.load(std::memory_order_acquire) == 1;
+  }
+
+  void increase() {
+    value.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // whether the caller held the last reference
+  bool release() {
+    return unique() || value.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+ private:
+  std::atomic<size_t> value;
+};
+#else
+struct ref_count {
+  ref_count() : value(1) {}
+
+  bool unique() const {
+    return value == 1;
+  }
+
+  void increase() {
+    value++;
+  }
+
+  bool release() {
+    return value-- == 1;
+  }
 
+ private:
+  size_t value;
+};
+#endif
+
+// Header followed by the limbs in the same block, so reaching the limbs from a buffer is a single indirection.
+// The limbs may start after a gap left by drop_front, so low limbs are dropped and put back without moving the rest.
 struct shared_container {
-  ~shared_container()  = default;
+  // empty container able to hold at least capacity limbs
+  static shared_container* create(size_t capacity) {
+    size_t bytes = limb_pool::good_size(sizeof(shared_container) + capacity * sizeof(uint32_t));
+    void* p = limb_pool::allocate(bytes);
+    return new(p) shared_container((bytes - sizeof(shared_container)) / sizeof(uint32_t));
+  }
 
-  explicit shared_container(std::vector<uint32_t> const& a) : ref_counter(1), vec(a) {}
-  shared_container(shared_container const& a) : ref_counter(1), vec(a.vec) {}
+  static shared_container* create(uint32_t const* first, uint32_t const* last, size_t capacity) {
+    size_t n = static_cast<size_t>(last - first);
+    shared_container* res = create(std::max(n, capacity));
+    std::copy(first, last, res->data());
+    res->size_ = n;
+    return res;
+  }
+
+  shared_container(shared_container const&) = delete;
+  shared_container& operator=(shared_container const&) = delete;
 
-  bool unique() {
-    return ref_counter == 1;
+  bool unique() const {
+    return ref_counter.unique();
   }
 
-  shared_container* make_unique() {
-    if (unique()) {
+  // own copy with room for at least capacity limbs, growing geometrically
+  shared_container* make_unique(size_t capacity) {
+    if (unique() && capacity <= this->capacity()) {
+      forget_decimal();
       return this;
-    } else {
-      ref_counter--;
-      return new shared_container(*this);
     }
-  }
 
-  void delete_instance() {
-    if (unique()) {
-      delete this;
-    } else {
-      ref_counter--;
+    if (capacity > this->capacity()) {
+      capacity = std::max(capacity, 2 * capacity_);
     }
+    shared_container* res = create(data(), data() + size_, capacity);
+    delete_instance();
+    return res;
   }
 
-  void reverse() {
-    std::reverse(vec.begin(), vec.end());
+  shared_container* make_unique() {
+    return make_unique(size_);
+  }
+
+  void delete_instance() {
+    if (ref_counter.release()) {
+      size_t bytes = sizeof(shared_container) + capacity_ * sizeof(uint32_t);
+      this->~shared_container();
+      limb_pool::deallocate(this, bytes);
+    }
   }
 
   void pop_back() {
-    vec.pop_back();
+    size_--;
   }
 
+  // the caller guarantees the capacity
   void push_back(uint32_t a) {
-    vec.push_back(a);
+    data()[size_++] = a;
+  }
+
+  void resize(size_t n) {
+    size_ = n;
+  }
+
+  // new limbs are set to fill
+  void resize(size_t n, uint32_t fill) {
+    if (n > size_) {
+      std::fill(data() + size_, data() + n, fill);
+    }
+    size_ = n;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // limbs that fit without moving the data
+  size_t capacity() const {
+    return capacity_ - offset_;
+  }
+
+  // the k lowest limbs are removed by growing the gap
+  void drop_front(size_t k) {
+    forget_decimal();
+    offset_ += k;
+    size_ -= k;
+  }
+
+  size_t front_room() const {
+    return offset_;
+  }
+
+  // the caller guarantees k <= front_room(), the new limbs are zero
+  void insert_front(size_t k) {
+    forget_decimal();
+    offset_ -= k;
+    size_ += k;
+    std::fill(data(), data() + k, 0);
+  }
+
+  uint32_t* data() {
+    return reinterpret_cast<uint32_t*>(this + 1) + offset_;
+  }
+
+  uint32_t const* data() const {
+    return reinterpret_cast<uint32_t const*>(this + 1) + offset_;
   }
 
   uint32_t const& back() const {
-    return vec.back();
+    return data()[size_ - 1];
   }
 
   uint32_t & operator[](size_t i) {
-    return vec[i];
+    return data()[i];
   }
 
   uint32_t const& operator[](size_t i) const {
-    return vec[i];
+    return data()[i];
   }
 
   void increase_ref() {
-    ref_counter++;
+    ref_counter.increase();
+  }
+
+  // digits of the magnitude, rendered on the first call and kept until the container is made unique for a write
+  template<typename F>
+  std::string decimal(F render) const {
+    std::string* cached = decimal_.load(std::memory_order_acquire);
+    if (cached == nullptr) {
+      std::string* fresh = new std::string(render());
+      // another reader of a shared container may have rendered them first
+      if (decimal_.compare_exchange_strong(cached, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        cached = fresh;
+      } else {
+        delete fresh;
+      }
+    }
+    return *cached;
   }
 
  private:
-  size_t ref_counter;
-  std::vector<uint32_t> vec;
+  explicit shared_container(size_t capacity) : decimal_(nullptr), offset_(0), size_(0), capacity_(capacity) {}
+
+  ~shared_container() {
+    delete decimal_.load(std::memory_order_relaxed);
+  }
+
+  // only called on unique containers, and nobody else can be reading the digits of those
+  void forget_decimal() {
+    std::string* cached = decimal_.load(std::memory_order_relaxed);
+    if (cached != nullptr) {
+      delete cached;
+      decimal_.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ref_count ref_counter;
+  mutable std::atomic<std::string*> decimal_;
+  size_t offset_;
+  size_t size_;
+  size_t capacity_;
 };
 
 #endif //BIGINT__SHARED_CONTAINER_H_
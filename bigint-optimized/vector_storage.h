@@ -0,0 +1,88 @@
+#ifndef BIGINT__VECTOR_STORAGE_H_
+#define BIGINT__VECTOR_STORAGE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "limb_pool.h"
+#include "limb_span.h"
+
+// plain std::vector limbs: every copy is deep, nothing is stored inline
+template<typename Allocator>
+struct basic_vector_storage {
+  explicit basic_vector_storage(uint32_t a) : limbs(1, a) {}
+
+  uint32_t& operator[](size_t i) {
+    return limbs[i];
+  }
+
+  uint32_t const& operator[](size_t i) const {
+    return limbs[i];
+  }
+
+  uint32_t const& back() const {
+    return limbs.back();
+  }
+
+  size_t get_size() const {
+    return limbs.size();
+  }
+
+  size_t capacity() const {
+    return limbs.capacity();
+  }
+
+  template<typename F>
+  std::string decimal(F render) const {
+    return render();
+  }
+
+  limb_span span() {
+    return {limbs.data(), limbs.size()};
+  }
+
+  const_limb_span span() const {
+    return {limbs.data(), limbs.size()};
+  }
+
+  const_limb_span cspan() const {
+    return span();
+  }
+
+  void push_back(uint32_t a) {
+    limbs.push_back(a);
+  }
+
+  void pop_back() {
+    limbs.pop_back();
+  }
+
+  void resize(size_t n) {
+    limbs.resize(n);
+  }
+
+  void resize(size_t n, uint32_t fill) {
+    limbs.resize(n, fill);
+  }
+
+  void reserve(size_t n) {
+    limbs.reserve(n);
+  }
+
+  void drop_front(size_t k) {
+    limbs.erase(limbs.begin(), limbs.begin() + k);
+  }
+
+  void insert_front(size_t k) {
+    limbs.insert(limbs.begin(), k, 0);
+  }
+
+ private:
+  std::vector<uint32_t, Allocator> limbs;
+};
+
+typedef basic_vector_storage<std::allocator<uint32_t>> vector_storage;
+// the same with blocks from the per-thread limb_pool
+typedef basic_vector_storage<pool_allocator<uint32_t>> pooled_storage;
+
+#endif //BIGINT__VECTOR_STORAGE_H_
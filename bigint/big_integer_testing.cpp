@@ -422,6 +422,13 @@ TEST(correctness, shr_signed) {
   EXPECT_EQ(-155, a);
 }
 
+TEST(correctness, shr_signed_exact) {
+  EXPECT_EQ(-2, big_integer(-4) >> 1);
+  EXPECT_EQ(-1, big_integer(-1) >> 40);
+  EXPECT_EQ(big_integer("-4294967296"), big_integer("-18446744073709551616") >> 32);
+  EXPECT_EQ(big_integer("-4294967297"), big_integer("-18446744073709551617") >> 32);
+}
+
 TEST(correctness, shr_return_value) {
   big_integer a = 64;
 
@@ -529,6 +536,14 @@ TEST(correctness, div_long_signed2) {
   EXPECT_EQ(c, a / b);
 }
 
+TEST(correctness, div_long_trial_overflow) {
+  big_integer a("340282366920938462356569963009195114496"); // (2^64 - 60) * 2^64
+  big_integer b("18446744073709551557");                    // 2^64 - 59
+
+  EXPECT_EQ(big_integer("18446744073709551614"), a / b);
+  EXPECT_EQ(big_integer("18446744073709551498"), a % b);
+}
+
 TEST(correctness, negation_long) {
   big_integer a("10000000000000000000000000000000000000000000000000000");
   big_integer c("-10000000000000000000000000000000000000000000000000000");